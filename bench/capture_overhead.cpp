@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench/mock_vmm.hh"
+#include "include/VolkDMA/capture.hh"
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+// Measures the per-frame cost of a capture stream against the simulated backend. The first
+// pass calls capture(), which reads every region in one scatter batch and then encodes and
+// writes the frame. The second pass feeds synthetic frames with a share of bytes changed
+// through write_frame(), then reads the last frame back and checks it.
+//
+// usage: CaptureOverhead [regions=64] [region_size=256] [frames=1000] [changed_percent=5] [round_trip_us=500]
+
+static void report(const char* name, const CaptureStats& stats) {
+    const double frames = static_cast<double>(stats.frames ? stats.frames : 1);
+    const double read_us = std::chrono::duration<double, std::micro>(stats.read_time).count() / frames;
+    const double encode_us = std::chrono::duration<double, std::micro>(stats.encode_time).count() / frames;
+    const double ratio = stats.raw_bytes ? static_cast<double>(stats.written_bytes) / static_cast<double>(stats.raw_bytes) : 0.0;
+
+    std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(2) << "frames " << stats.frames << "  read " << std::setw(8) << read_us
+              << " us/frame  encode+write " << std::setw(8) << encode_us << " us/frame  size " << std::setprecision(4) << ratio << " of raw" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const size_t region_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const size_t region_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256;
+    const size_t frame_count = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+    const size_t changed_percent = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 5;
+    const uint32_t round_trip_us = argc > 5 ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 500;
+
+    MockVmm::set_latency(round_trip_us, 200);
+    Log::set_level(LogLevel::warning);
+
+    DMA dma(false);
+    Process process(dma, "game.exe");
+
+    std::vector<CaptureRegion> regions;
+    for (size_t i = 0; i < region_count; ++i) {
+        regions.push_back({ 0x10000000 + i * 0x10000, region_size });
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "VolkDMA.capture_overhead.bin";
+    bool failed = false;
+
+    {
+        CaptureWriter writer(process, path, regions);
+        for (size_t i = 0; i < frame_count && writer; ++i) {
+            failed |= !writer.capture();
+        }
+        writer.flush();
+        report("capture", writer.get_stats());
+    }
+
+    std::vector<uint8_t> state(region_count * region_size);
+    {
+        CaptureWriter writer(process, path, regions);
+        std::mt19937_64 random(1);
+        const size_t changes = state.size() * changed_percent / 100;
+
+        for (size_t i = 0; i < frame_count && writer; ++i) {
+            for (size_t k = 0; k < changes; ++k) {
+                state[random() % state.size()] = static_cast<uint8_t>(random());
+            }
+            failed |= !writer.write_frame(state);
+        }
+        writer.flush();
+        report("encode", writer.get_stats());
+    }
+
+    CaptureReader reader(path);
+    std::vector<uint8_t> decoded;
+    if (!reader || reader.get_frame_count() != frame_count || !reader.read_frame(frame_count - 1, decoded) || decoded != state) {
+        std::cout << "read back failed" << std::endl;
+        failed = true;
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    Log::flush();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+#include "bench/mock_vmm.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "external/vmm/vmmdll.h"
+
+// Simulated vmm.dll for the benchmarks. Every address reads back as itself, so results can
+// be verified, and every module is found at the same base. Executing a scatter handle
+// sleeps for a fixed round trip plus a cost per entry, the way a real device blocks the
+// calling thread. Like the real device, which serves one request at a time, every round
+// trip holds a single device mutex, so concurrent callers queue instead of overlapping.
+// Entry points the benchmarks never reach only exist so the library links.
+
+static std::atomic<uint32_t> round_trip_us{ 500 };
+static std::atomic<uint32_t> entry_ns{ 200 };
+static std::atomic<uint64_t> executed_batches{ 0 };
+static std::atomic<uint64_t> executed_entries{ 0 };
+static std::atomic<uint64_t> busy_ns{ 0 };
+static std::mutex device_mutex;
+static int mock_vmm = 0;
+static constexpr uint64_t mock_module_base = 0x140000000;
+
+struct MockScatter {
+    struct Entry {
+        uint64_t address;
+        uint32_t size;
+        uint8_t* buffer;
+        DWORD* bytes_read;
+    };
+
+    std::vector<Entry> entries;
+};
+
+void MockVmm::set_latency(uint32_t round_trip_microseconds, uint32_t entry_nanoseconds) {
+    round_trip_us.store(round_trip_microseconds, std::memory_order_relaxed);
+    entry_ns.store(entry_nanoseconds, std::memory_order_relaxed);
+}
+
+uint64_t MockVmm::get_batch_count() {
+    return executed_batches.load(std::memory_order_relaxed);
+}
+
+uint64_t MockVmm::get_entry_count() {
+    return executed_entries.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds MockVmm::get_busy_time() {
+    return std::chrono::nanoseconds(busy_ns.load(std::memory_order_relaxed));
+}
+
+static void round_trip(std::chrono::nanoseconds duration) {
+    std::lock_guard lock(device_mutex);
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    busy_ns.fetch_add(static_cast<uint64_t>((std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+}
+
+static void fill(uint64_t address, uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        const uint64_t aligned = (address + i) & ~uint64_t{ 7 };
+        buffer[i] = static_cast<uint8_t>(aligned >> (((address + i) & 7) * 8));
+    }
+}
+
+extern "C" {
+
+VMM_HANDLE VMMDLL_Initialize(DWORD, LPCSTR[]) {
+    return reinterpret_cast<VMM_HANDLE>(&mock_vmm);
+}
+
+VOID VMMDLL_Close(VMM_HANDLE) {}
+
+VOID VMMDLL_MemFree(PVOID pvMem) {
+    std::free(pvMem);
+}
+
+BOOL VMMDLL_ConfigGet(VMM_HANDLE, ULONG64, PULONG64 pqwValue) {
+    *pqwValue = 0;
+    return FALSE;
+}
+
+BOOL VMMDLL_ConfigSet(VMM_HANDLE, ULONG64, ULONG64) {
+    return FALSE;
+}
+
+BOOL VMMDLL_InitializePlugins(VMM_HANDLE) {
+    return FALSE;
+}
+
+BOOL VMMDLL_PidGetFromName(VMM_HANDLE, LPCSTR, PDWORD pdwPID) {
+    *pdwPID = 4;
+    return TRUE;
+}
+
+BOOL VMMDLL_ProcessGetInformationAll(VMM_HANDLE, PVMMDLL_PROCESS_INFORMATION* ppProcessInformationAll, PDWORD pcProcessInformation) {
+    *ppProcessInformationAll = nullptr;
+    *pcProcessInformation = 0;
+    return FALSE;
+}
+
+BOOL VMMDLL_Map_GetPhysMem(VMM_HANDLE, PVMMDLL_MAP_PHYSMEM* ppPhysMemMap) {
+    *ppPhysMemMap = nullptr;
+    return FALSE;
+}
+
+BOOL VMMDLL_Map_GetModuleU(VMM_HANDLE, DWORD, PVMMDLL_MAP_MODULE* ppModuleMap, DWORD) {
+    *ppModuleMap = nullptr;
+    return FALSE;
+}
+
+BOOL VMMDLL_Map_GetModuleFromNameU(VMM_HANDLE, DWORD, LPCSTR, PVMMDLL_MAP_MODULEENTRY* ppModuleMapEntry, DWORD) {
+    PVMMDLL_MAP_MODULEENTRY entry = static_cast<PVMMDLL_MAP_MODULEENTRY>(std::calloc(1, sizeof(VMMDLL_MAP_MODULEENTRY)));
+    if (!entry) {
+        *ppModuleMapEntry = nullptr;
+        return FALSE;
+    }
+
+    entry->vaBase = mock_module_base;
+    entry->cbImageSize = 0x100000;
+    *ppModuleMapEntry = entry;
+    return TRUE;
+}
+
+BOOL VMMDLL_VfsListU(VMM_HANDLE, LPCSTR, PVMMDLL_VFS_FILELIST2) {
+    return FALSE;
+}
+
+NTSTATUS VMMDLL_VfsReadW(VMM_HANDLE, LPCWSTR, PBYTE, DWORD, PDWORD pcbRead, ULONG64) {
+    *pcbRead = 0;
+    return VMMDLL_STATUS_FILE_INVALID;
+}
+
+BOOL VMMDLL_VirtualToPhysical(VMM_HANDLE, ULONG64, PULONG64 physicalAddress) {
+    *physicalAddress = 0;
+    return FALSE;
+}
+
+BOOL VMMDLL_MemReadEx(VMM_HANDLE, DWORD, ULONG64 qwA, PBYTE pb, DWORD cb, PDWORD pcbReadOpt, ULONG64) {
+    round_trip(std::chrono::microseconds(round_trip_us.load(std::memory_order_relaxed)));
+    fill(qwA, pb, cb);
+    if (pcbReadOpt) {
+        *pcbReadOpt = cb;
+    }
+    return TRUE;
+}
+
+BOOL VMMDLL_MemWrite(VMM_HANDLE, DWORD, ULONG64, PBYTE, DWORD) {
+    return TRUE;
+}
+
+VMMDLL_SCATTER_HANDLE VMMDLL_Scatter_Initialize(VMM_HANDLE, DWORD, DWORD) {
+    return reinterpret_cast<VMMDLL_SCATTER_HANDLE>(new MockScatter());
+}
+
+BOOL VMMDLL_Scatter_PrepareEx(VMMDLL_SCATTER_HANDLE hS, QWORD va, DWORD cb, PBYTE pb, PDWORD pcbRead) {
+    if (pcbRead) {
+        *pcbRead = 0;
+    }
+    reinterpret_cast<MockScatter*>(hS)->entries.push_back({ va, cb, pb, pcbRead });
+    return TRUE;
+}
+
+BOOL VMMDLL_Scatter_PrepareWrite(VMMDLL_SCATTER_HANDLE hS, QWORD va, PBYTE, DWORD cb) {
+    reinterpret_cast<MockScatter*>(hS)->entries.push_back({ va, cb, nullptr, nullptr });
+    return TRUE;
+}
+
+BOOL VMMDLL_Scatter_Execute(VMMDLL_SCATTER_HANDLE hS) {
+    MockScatter* scatter = reinterpret_cast<MockScatter*>(hS);
+    const uint64_t entries = scatter->entries.size();
+
+    round_trip(std::chrono::microseconds(round_trip_us.load(std::memory_order_relaxed)) + std::chrono::nanoseconds(entry_ns.load(std::memory_order_relaxed) * entries));
+
+    for (const MockScatter::Entry& entry : scatter->entries) {
+        if (entry.buffer) {
+            fill(entry.address, entry.buffer, entry.size);
+        }
+        if (entry.bytes_read) {
+            *entry.bytes_read = entry.size;
+        }
+    }
+
+    executed_batches.fetch_add(1, std::memory_order_relaxed);
+    executed_entries.fetch_add(entries, std::memory_order_relaxed);
+    return TRUE;
+}
+
+BOOL VMMDLL_Scatter_Clear(VMMDLL_SCATTER_HANDLE hS, DWORD, DWORD) {
+    reinterpret_cast<MockScatter*>(hS)->entries.clear();
+    return TRUE;
+}
+
+VOID VMMDLL_Scatter_CloseHandle(VMMDLL_SCATTER_HANDLE hS) {
+    delete reinterpret_cast<MockScatter*>(hS);
+}
+
+HANDLE LcCreate(PLC_CONFIG) {
+    return nullptr;
+}
+
+VOID LcClose(HANDLE) {}
+
+BOOL LcCommand(HANDLE, QWORD, DWORD, PBYTE, PBYTE* ppbDataOut, PDWORD pcbDataOut) {
+    if (ppbDataOut) {
+        *ppbDataOut = nullptr;
+    }
+    if (pcbDataOut) {
+        *pcbDataOut = 0;
+    }
+    return FALSE;
+}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Controls for the simulated backend in mock_vmm.cpp, which stands in for vmm.lib.
+class MockVmm {
+public:
+    static void set_latency(uint32_t round_trip_microseconds, uint32_t entry_nanoseconds);
+    [[nodiscard]] static uint64_t get_batch_count();
+    [[nodiscard]] static uint64_t get_entry_count();
+    // Total time the simulated device spent serving round trips.
+    [[nodiscard]] static std::chrono::nanoseconds get_busy_time();
+};
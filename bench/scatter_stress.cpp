@@ -0,0 +1,113 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench/mock_vmm.hh"
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+// Stress benchmark for concurrent use of one Process against the simulated backend. Each
+// worker repeatedly leases a scatter context, queues a batch of 8-byte reads at random
+// addresses, executes it and checks every value. The simulated device serves one round
+// trip at a time, so throughput is capped by the device, not the thread count. What the
+// run shows is how busy the device stays: with more threads, building and checking batches
+// should overlap other threads' round trips, and busy time below that of one thread points
+// at contention in the pool or handle locking.
+//
+// usage: ScatterStress [max_threads=8] [reads_per_batch=64] [milliseconds=1000] [round_trip_us=500]
+
+struct RunResult {
+    uint64_t reads = 0;
+    uint64_t mismatches = 0;
+    double seconds = 0.0;
+    double device_busy = 0.0;
+};
+
+static RunResult run(const Process& process, size_t thread_count, size_t reads_per_batch, std::chrono::milliseconds duration) {
+    std::atomic<bool> stop{ false };
+    std::atomic<uint64_t> reads{ 0 };
+    std::atomic<uint64_t> mismatches{ 0 };
+    std::vector<std::thread> workers;
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds busy_start = MockVmm::get_busy_time();
+    for (size_t t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 random(t + 1);
+            std::vector<uint64_t> addresses(reads_per_batch);
+            std::vector<uint64_t> values(reads_per_batch);
+            uint64_t local_reads = 0;
+            uint64_t local_mismatches = 0;
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                ScatterContext scatter = process.acquire_scatter();
+                for (size_t i = 0; i < reads_per_batch; ++i) {
+                    addresses[i] = 0x10000 + (random() % 0x7FFF0000) * 8;
+                    values[i] = 0;
+                    scatter.add_read(addresses[i], &values[i]);
+                }
+
+                if (!scatter.execute()) {
+                    local_mismatches += reads_per_batch;
+                    continue;
+                }
+
+                for (size_t i = 0; i < reads_per_batch; ++i) {
+                    local_mismatches += values[i] != addresses[i];
+                }
+                local_reads += reads_per_batch;
+            }
+
+            reads.fetch_add(local_reads, std::memory_order_relaxed);
+            mismatches.fetch_add(local_mismatches, std::memory_order_relaxed);
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const std::chrono::duration<double> busy = MockVmm::get_busy_time() - busy_start;
+    return { reads.load(), mismatches.load(), elapsed.count(), busy.count() / elapsed.count() };
+}
+
+int main(int argc, char** argv) {
+    const size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    const size_t reads_per_batch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    const std::chrono::milliseconds duration(argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000);
+    const uint32_t round_trip_us = argc > 4 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 500;
+
+    MockVmm::set_latency(round_trip_us, 200);
+    Log::set_level(LogLevel::warning);
+
+    DMA dma(false);
+    Process process(dma, "game.exe");
+
+    double baseline = 0.0;
+    bool failed = false;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        const RunResult result = run(process, threads, reads_per_batch, duration);
+        const double throughput = static_cast<double>(result.reads) / result.seconds;
+        if (threads == 1) {
+            baseline = throughput;
+        }
+
+        std::cout << "threads " << std::setw(2) << threads << ": " << std::fixed << std::setprecision(0) << std::setw(10) << throughput << " reads/s  scaling "
+                  << std::setprecision(2) << std::setw(5) << (baseline > 0.0 ? throughput / baseline : 0.0) << "x  device busy " << std::setw(5) << result.device_busy * 100.0 << "%  mismatches " << result.mismatches << std::endl;
+        failed |= result.mismatches != 0;
+    }
+
+    std::cout << "batches " << MockVmm::get_batch_count() << ", entries " << MockVmm::get_entry_count() << std::endl;
+    Log::flush();
+    return failed ? 1 : 0;
+}
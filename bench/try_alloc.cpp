@@ -0,0 +1,85 @@
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string_view>
+
+#include "bench/mock_vmm.hh"
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+// Checks that the try_* APIs never touch the C++ heap. The global operator new counts every
+// allocation made while counting is enabled, and the run fails if one happens between the
+// warm-up call and the end of the loop. Allocations made inside vmm.dll, such as the module
+// entry behind try_get_base_address(), go through its own allocator and are not counted.
+//
+// usage: TryAlloc [iterations=1000]
+
+static std::atomic<bool> counting{ false };
+static std::atomic<uint64_t> allocations{ 0 };
+
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+static bool run_once(const Process& process) {
+    static constexpr std::array<uint64_t, 3> offsets = { 0x10, 0x20, 0x30 };
+    constexpr std::string_view module_name = "game.exe";
+
+    const VolkResult<uint64_t> base_address = process.try_get_base_address(module_name);
+    if (!base_address) {
+        return false;
+    }
+
+    const VolkResult<uint64_t> pointer = process.try_read_chain(base_address.value, offsets);
+    const VolkResult<uint32_t> value = process.try_read_chain<uint32_t>(base_address.value, offsets);
+    const VolkResult<uint64_t> direct = process.try_read<uint64_t>(base_address.value + 0x40);
+
+    // Unrelated failures must stay allocation free as well.
+    const VolkResult<uint64_t> empty_chain = process.try_read_chain(base_address.value, std::span<const uint64_t>{});
+
+    return pointer && value && direct && !empty_chain;
+}
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+
+    MockVmm::set_latency(0, 0);
+    Log::set_level(LogLevel::error);
+
+    DMA dma(false);
+    Process process(dma, "game.exe");
+
+    if (!run_once(process)) {
+        std::cout << "warm-up call failed" << std::endl;
+        return 1;
+    }
+
+    counting.store(true, std::memory_order_relaxed);
+    bool success = true;
+    for (size_t i = 0; i < iterations; ++i) {
+        success &= run_once(process);
+    }
+    counting.store(false, std::memory_order_relaxed);
+
+    std::cout << "iterations " << iterations << ", allocations " << allocations.load() << ", failures " << process.get_failure_count() << std::endl;
+    Log::flush();
+    return success && allocations.load() == 0 ? 0 : 1;
+}
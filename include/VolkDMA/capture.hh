@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+class Process;
+using DWORD = unsigned long;
+
+struct CaptureRegion {
+    uint64_t address = 0;
+    size_t size = 0;
+};
+
+// read_time is spent in the scatter read of capture(); encode_time covers encoding and
+// writing a frame, so the two together are the capture overhead per frame.
+struct CaptureStats {
+    uint64_t frames = 0;
+    uint64_t keyframes = 0;
+    uint64_t raw_bytes = 0;
+    uint64_t written_bytes = 0;
+    std::chrono::nanoseconds read_time{ 0 };
+    std::chrono::nanoseconds encode_time{ 0 };
+};
+
+// Records the watched regions of a process as a compact frame stream. A frame is the
+// concatenation of all regions in the order given; every keyframe_interval frames it is
+// stored whole, otherwise as the XOR against the previous frame with unchanged runs
+// skipped. Because the delta is an XOR, a reader can apply it in either direction. Each
+// frame also stores one validity bit per region, so a region that could not be read is
+// not mistaken for one that held zeros.
+class CaptureWriter {
+public:
+    CaptureWriter(const Process& process, const std::filesystem::path& path, std::vector<CaptureRegion> regions, uint32_t keyframe_interval = 256);
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    bool capture();
+    // valid_mask holds one bit per region, least significant bit first; empty means all valid.
+    bool write_frame(std::span<const uint8_t> state, std::span<const uint8_t> valid_mask = {});
+    void flush();
+
+    [[nodiscard]] const CaptureStats& get_stats() const { return stats; }
+    [[nodiscard]] size_t get_frame_size() const { return frame_size; }
+    explicit operator bool() const { return file.is_open() && file.good(); }
+
+private:
+    const Process& process;
+    std::vector<CaptureRegion> regions;
+    uint32_t keyframe_interval;
+    size_t frame_size = 0;
+    std::ofstream file;
+    std::chrono::steady_clock::time_point start;
+    CaptureStats stats{};
+
+    std::vector<uint8_t> current;
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> valid;
+    std::vector<uint8_t> record;
+    std::vector<DWORD> bytes_read;
+};
+
+// Random access over a file written by CaptureWriter. Opening scans the record headers
+// once; read_frame() decodes forward from the nearest keyframe, or from the last decoded
+// frame when it is closer, so sequential playback costs one delta per frame.
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::filesystem::path& path);
+
+    bool read_frame(size_t index, std::vector<uint8_t>& state);
+
+    [[nodiscard]] size_t get_frame_count() const { return frames.size(); }
+    [[nodiscard]] size_t get_frame_size() const { return frame_size; }
+    [[nodiscard]] const std::vector<CaptureRegion>& get_regions() const { return regions; }
+    [[nodiscard]] size_t get_region_offset(size_t region) const;
+    [[nodiscard]] bool is_region_valid(size_t index, size_t region) const;
+    [[nodiscard]] std::chrono::nanoseconds get_timestamp(size_t index) const;
+    explicit operator bool() const { return file.is_open() && frame_size != 0; }
+
+private:
+    struct FrameRecord {
+        uint64_t offset;
+        uint64_t timestamp;
+        uint32_t size;
+        bool keyframe;
+    };
+
+    std::ifstream file;
+    std::vector<CaptureRegion> regions;
+    size_t frame_size = 0;
+    size_t mask_size = 0;
+    std::vector<FrameRecord> frames;
+    std::vector<size_t> keyframes;
+    std::vector<uint8_t> masks;
+
+    std::vector<uint8_t> state;
+    std::vector<uint8_t> record;
+    size_t decoded = static_cast<size_t>(-1);
+
+    bool apply(size_t index);
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+
+class Process;
+class ReadExecutor;
+using DWORD = unsigned long;
+
+// Coroutine type for code that awaits Process::read_async. Tasks are lazy; hand them to
+// a ReadExecutor with spawn(), which owns and destroys them.
+class ReadTask {
+public:
+    struct promise_type {
+        ReadExecutor* executor = nullptr;
+        size_t index = 0;
+
+        ReadTask get_return_object() { return ReadTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    ReadTask() = default;
+    ~ReadTask() { if (handle) handle.destroy(); }
+
+    ReadTask(const ReadTask&) = delete;
+    ReadTask& operator=(const ReadTask&) = delete;
+
+    ReadTask(ReadTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    ReadTask& operator=(ReadTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+private:
+    friend class ReadExecutor;
+    explicit ReadTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle = nullptr;
+};
+
+// Runs ReadTasks in ticks. Every read awaited by a task is queued instead of executed;
+// tick() issues all queued reads as one scatter per process and then resumes the
+// waiting tasks, which queue their next (possibly dependent) reads for the next tick.
+// An executor and its tasks must be driven by one thread.
+class ReadExecutor {
+public:
+    ReadExecutor() = default;
+    ~ReadExecutor();
+
+    ReadExecutor(const ReadExecutor&) = delete;
+    ReadExecutor& operator=(const ReadExecutor&) = delete;
+
+    void spawn(ReadTask task);
+    size_t tick();
+    size_t run(size_t max_ticks = static_cast<size_t>(-1));
+
+    [[nodiscard]] size_t size() const { return tasks.size(); }
+    [[nodiscard]] size_t get_pending_count() const { return pending.size(); }
+
+private:
+    template <typename T>
+    friend class ReadAwaitable;
+    friend struct ReadTask::promise_type;
+
+    struct PendingRead {
+        const Process* process;
+        uint64_t address;
+        void* buffer;
+        size_t size;
+        DWORD* bytes_read;
+        std::coroutine_handle<ReadTask::promise_type> handle;
+    };
+
+    std::vector<std::coroutine_handle<ReadTask::promise_type>> tasks;
+    std::vector<PendingRead> pending;
+    std::vector<PendingRead> batch;
+    std::exception_ptr exception;
+
+    void resume(std::coroutine_handle<ReadTask::promise_type> handle);
+    void enqueue(const PendingRead& read) { pending.push_back(read); }
+};
+
+// Awaiter returned by Process::read_async. The value lives in the awaiting coroutine's
+// frame until the executor fills it; failed reads yield a zeroed T, as read<T> does.
+template <typename T>
+class ReadAwaitable {
+public:
+    ReadAwaitable(const Process* process, uint64_t address, bool valid) : process(process), address(address), valid(valid) {}
+
+    bool await_ready() const noexcept { return !valid; }
+
+    void await_suspend(std::coroutine_handle<ReadTask::promise_type> handle) {
+        handle.promise().executor->enqueue({ process, address, &value, sizeof(T), &bytes_read, handle });
+    }
+
+    T await_resume() const noexcept { return bytes_read == sizeof(T) ? value : T{}; }
+
+private:
+    const Process* process;
+    uint64_t address;
+    bool valid;
+    DWORD bytes_read = 0;
+    T value{};
+};
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct tdVMM_HANDLE;
@@ -20,8 +21,8 @@ public:
 
     VolkHandle handle{};
 
-    [[nodiscard]] DWORD get_process_id(const std::string& process_name) const;
-    [[nodiscard]] std::vector<DWORD> get_process_id_list(const std::string& process_name) const;
+    [[nodiscard]] DWORD get_process_id(std::string_view process_name) const;
+    [[nodiscard]] std::vector<DWORD> get_process_id_list(std::string_view process_name) const;
     [[nodiscard]] uint64_t find_signature(const char* signature, uint64_t range_start, uint64_t range_end, DWORD process_id) const;
 
     template<typename T>
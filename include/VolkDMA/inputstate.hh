@@ -2,16 +2,19 @@
 
 #include <array>
 #include <cstdint>
+#include <filesystem>
 #include <string_view>
 #include <vector>
 
 class DMA;
+class SymbolResolver;
 
 using DWORD = unsigned long;
 
 class InputState {
 public:
-    explicit InputState(const DMA& dma);
+    // An empty symbol_cache_path keeps the symbol cache at SymbolResolver's default location.
+    explicit InputState(const DMA& dma, const std::filesystem::path& symbol_cache_path = {});
 
     struct Point {
         int32_t x;
@@ -200,6 +203,6 @@ private:
     uint64_t gafAsyncKeyState_address{};
     std::array<uint8_t, 64> state_bitmap{};
 
-    [[nodiscard]] bool retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_process_ids);
+    [[nodiscard]] bool retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_process_ids, SymbolResolver& symbols);
     [[nodiscard]] bool retrieve_gptCursorAsync(const std::vector<DWORD>& csrss_process_ids);
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// Null-terminated copy of a string_view in a fixed stack buffer, for passing names to the
+// vmm C API without a heap allocation. Views that do not fit leave the string empty.
+template <size_t N = 260>
+class StackString {
+public:
+    explicit StackString(std::string_view text) {
+        buffer[0] = '\0';
+        if (text.size() < N) {
+            std::memcpy(buffer, text.data(), text.size());
+            buffer[text.size()] = '\0';
+            valid = true;
+        }
+    }
+
+    [[nodiscard]] const char* c_str() const { return buffer; }
+    explicit operator bool() const { return valid; }
+
+private:
+    char buffer[N];
+    bool valid = false;
+};
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "include/VolkDMA/process.hh"
+
+// using PlayerLayout = RemoteLayout<Player, RemoteField<&Player::position, 0x1A0>, RemoteField<&Player::health, 0x2F0>>;
+// PlayerLayout::select<&Player::health>::read(process, bases, players);
+
+template <typename T>
+struct RemoteMemberTraits;
+
+template <typename C, typename M>
+struct RemoteMemberTraits<M C::*> {
+    using class_type = C;
+    using member_type = M;
+};
+
+template <auto Member, uint64_t Offset>
+struct RemoteField {
+    using class_type = typename RemoteMemberTraits<decltype(Member)>::class_type;
+    using member_type = typename RemoteMemberTraits<decltype(Member)>::member_type;
+
+    static_assert(std::is_trivially_copyable_v<member_type>, "Remote fields must be trivially copyable.");
+
+    static constexpr auto member = Member;
+    static constexpr uint64_t offset = Offset;
+    static constexpr size_t size = sizeof(member_type);
+};
+
+struct RemoteSpan {
+    uint64_t offset;
+    size_t size;
+    size_t staging_offset;
+};
+
+namespace remote_layout_detail {
+    template <auto A, auto B>
+    constexpr bool same_member() {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <auto Member, typename... Fields>
+    struct find_field;
+
+    template <auto Member, typename Field, typename... Rest>
+    struct find_field<Member, Field, Rest...> {
+        using type = std::conditional_t<same_member<Member, Field::member>(), Field, typename find_field<Member, Rest...>::type>;
+    };
+
+    template <auto Member>
+    struct find_field<Member> {
+        using type = void;
+    };
+
+    template <size_t N>
+    struct MergedSpans {
+        std::array<RemoteSpan, N> spans{};
+        std::array<size_t, N> field_staging{};
+        size_t count = 0;
+        size_t stride = 0;
+    };
+
+    // Merges overlapping or touching fields, plus gaps up to max_gap bytes, into one span.
+    template <size_t N>
+    constexpr MergedSpans<N> merge_spans(const std::array<uint64_t, N>& offsets, const std::array<size_t, N>& sizes, size_t max_gap) {
+        MergedSpans<N> result{};
+        if constexpr (N == 0) {
+            return result;
+        }
+        else {
+            std::array<size_t, N> order{};
+            for (size_t i = 0; i < N; ++i) {
+                order[i] = i;
+            }
+
+            for (size_t i = 1; i < N; ++i) {
+                for (size_t j = i; j > 0 && offsets[order[j]] < offsets[order[j - 1]]; --j) {
+                    const size_t swap = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = swap;
+                }
+            }
+
+            std::array<size_t, N> field_span{};
+            for (size_t k = 0; k < N; ++k) {
+                const size_t i = order[k];
+                const uint64_t begin = offsets[i];
+                const uint64_t end = begin + sizes[i];
+
+                if (result.count != 0) {
+                    RemoteSpan& last = result.spans[result.count - 1];
+                    const uint64_t last_end = last.offset + last.size;
+                    if (begin <= last_end + max_gap) {
+                        if (end > last_end) {
+                            last.size = static_cast<size_t>(end - last.offset);
+                        }
+                        field_span[i] = result.count - 1;
+                        continue;
+                    }
+                }
+
+                result.spans[result.count] = { begin, sizes[i], 0 };
+                field_span[i] = result.count;
+                ++result.count;
+            }
+
+            for (size_t s = 0; s < result.count; ++s) {
+                result.spans[s].staging_offset = result.stride;
+                result.stride += result.spans[s].size;
+            }
+
+            for (size_t i = 0; i < N; ++i) {
+                const RemoteSpan& span = result.spans[field_span[i]];
+                result.field_staging[i] = span.staging_offset + static_cast<size_t>(offsets[i] - span.offset);
+            }
+
+            return result;
+        }
+    }
+}
+
+template <typename T, size_t MaxGap, typename... Fields>
+class RemoteSelection {
+    static_assert((!std::is_void_v<Fields> && ...), "Selected member is not declared in the layout.");
+
+public:
+    using value_type = T;
+
+    static constexpr size_t field_count = sizeof...(Fields);
+
+private:
+    static constexpr auto merged = remote_layout_detail::merge_spans<field_count>({ Fields::offset... }, { Fields::size... }, MaxGap);
+
+    template <size_t... I>
+    static constexpr std::array<RemoteSpan, sizeof...(I)> trim_spans(std::index_sequence<I...>) {
+        return { merged.spans[I]... };
+    }
+
+public:
+    static constexpr size_t span_count = merged.count;
+    static constexpr size_t stride = merged.stride;
+    static constexpr std::array<RemoteSpan, span_count> spans = trim_spans(std::make_index_sequence<span_count>{});
+
+    // Instances with an invalid base address are left untouched.
+    static bool read(const Process& process, std::span<const uint64_t> bases, std::span<T> out) {
+        std::vector<uint8_t> staging;
+        return read(process, bases, out, staging);
+    }
+
+    static bool read(const Process& process, std::span<const uint64_t> bases, std::span<T> out, std::vector<uint8_t>& staging) {
+        if (bases.size() != out.size()) {
+            return false;
+        }
+
+        if (bases.empty()) {
+            return true;
+        }
+
+        staging.resize(stride * bases.size());
+
+        ScatterContext scatter = process.acquire_scatter();
+        if (!scatter) {
+            return false;
+        }
+
+        bool success = true;
+        for (size_t i = 0; i < bases.size(); ++i) {
+            if (!process.is_valid_address(bases[i])) {
+                continue;
+            }
+
+            uint8_t* instance = staging.data() + i * stride;
+            for (const RemoteSpan& span : spans) {
+                success &= scatter.add_read(bases[i] + span.offset, instance + span.staging_offset, span.size);
+            }
+        }
+
+        success &= scatter.execute();
+
+        for (size_t i = 0; i < bases.size(); ++i) {
+            if (process.is_valid_address(bases[i])) {
+                unpack(staging.data() + i * stride, out[i], std::make_index_sequence<field_count>{});
+            }
+        }
+
+        return success;
+    }
+
+    static bool read(const Process& process, uint64_t base, T& out) {
+        return read(process, std::span<const uint64_t>(&base, 1), std::span<T>(&out, 1));
+    }
+
+private:
+    template <size_t... I>
+    static void unpack(const uint8_t* instance, T& out, std::index_sequence<I...>) {
+        (std::memcpy(&(out.*(Fields::member)), instance + merged.field_staging[I], Fields::size), ...);
+    }
+};
+
+template <typename T, typename... Fields>
+class RemoteLayout {
+    static_assert((std::is_same_v<typename Fields::class_type, T> && ...), "Every field must be a member of the layout type.");
+
+    template <auto Member>
+    using field_for = typename remote_layout_detail::find_field<Member, Fields...>::type;
+
+public:
+    template <auto... Members>
+    using select = RemoteSelection<T, 0, field_for<Members>...>;
+
+    template <size_t MaxGap, auto... Members>
+    using select_with_gap = RemoteSelection<T, MaxGap, field_for<Members>...>;
+
+    using all = RemoteSelection<T, 0, Fields...>;
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+enum class LogLevel : uint8_t {
+    debug,
+    info,
+    warning,
+    error,
+};
+
+using LogSink = std::function<void(LogLevel level, std::string_view message)>;
+
+struct LogArgument {
+    enum class Type : uint8_t {
+        signed_integer,
+        unsigned_integer,
+        floating,
+        string,
+    };
+
+    Type type;
+    union {
+        int64_t signed_value;
+        uint64_t unsigned_value;
+        double floating_value;
+        struct {
+            uint16_t offset;
+            uint16_t size;
+        } text;
+    };
+};
+
+// Fixed-size log entry. Arguments are captured by value and strings are copied into the
+// record, so a record can be formatted after the caller has moved on.
+struct LogRecord {
+    static constexpr size_t max_arguments = 8;
+    static constexpr size_t text_capacity = 192;
+
+    const char* format = nullptr;
+    LogLevel level = LogLevel::info;
+    uint8_t argument_count = 0;
+    uint16_t text_size = 0;
+    uint32_t suppressed = 0;
+    LogArgument arguments[max_arguments];
+    char text[text_capacity];
+
+    template <typename T>
+    void add(const T& value) {
+        if (this->argument_count == max_arguments) {
+            return;
+        }
+
+        LogArgument& argument = this->arguments[this->argument_count++];
+        if constexpr (std::is_enum_v<T>) {
+            argument.type = LogArgument::Type::signed_integer;
+            argument.signed_value = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            argument.type = LogArgument::Type::floating;
+            argument.floating_value = static_cast<double>(value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            argument.type = LogArgument::Type::signed_integer;
+            argument.signed_value = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            argument.type = LogArgument::Type::unsigned_integer;
+            argument.unsigned_value = static_cast<uint64_t>(value);
+        }
+        else if constexpr (std::is_pointer_v<T> && !std::is_convertible_v<T, const char*>) {
+            argument.type = LogArgument::Type::unsigned_integer;
+            argument.unsigned_value = reinterpret_cast<uintptr_t>(value);
+        }
+        else if constexpr (std::is_convertible_v<const T&, const char*>) {
+            const char* text = value;
+            this->add_text(argument, text ? std::string_view(text) : std::string_view("(null)"));
+        }
+        else {
+            this->add_text(argument, std::string_view(value));
+        }
+    }
+
+    void add_text(LogArgument& argument, std::string_view value) {
+        const size_t size = std::min<size_t>(value.size(), text_capacity - this->text_size);
+        argument.type = LogArgument::Type::string;
+        argument.text.offset = this->text_size;
+        argument.text.size = static_cast<uint16_t>(size);
+        std::memcpy(this->text + this->text_size, value.data(), size);
+        this->text_size += static_cast<uint16_t>(size);
+    }
+};
+
+// Asynchronous logger. Callers only capture their arguments into a LogRecord and push it
+// onto a bounded lock-free ring; a background thread formats records and hands the lines
+// to the registered sinks. Messages sharing a format string are rate limited, and the
+// number of suppressed messages is appended to the next one that gets through. When the
+// ring is full, records are dropped rather than blocking the caller.
+//
+// Format strings must be string literals and use {} for a value or {:x} for hex.
+class Log {
+public:
+    template <typename... Args>
+    static void debug(const char* format, const Args&... args) { write(LogLevel::debug, format, args...); }
+
+    template <typename... Args>
+    static void info(const char* format, const Args&... args) { write(LogLevel::info, format, args...); }
+
+    template <typename... Args>
+    static void warning(const char* format, const Args&... args) { write(LogLevel::warning, format, args...); }
+
+    template <typename... Args>
+    static void error(const char* format, const Args&... args) { write(LogLevel::error, format, args...); }
+
+    template <typename... Args>
+    static void write(LogLevel level, const char* format, const Args&... args) {
+        uint32_t suppressed = 0;
+        if (!admit(level, format, suppressed)) {
+            return;
+        }
+
+        LogRecord record;
+        record.format = format;
+        record.level = level;
+        record.suppressed = suppressed;
+        (record.add(args), ...);
+        submit(record);
+    }
+
+    static void set_level(LogLevel level);
+    static void set_rate_limit(uint32_t messages_per_second);
+    static void add_sink(LogSink sink);
+    static void clear_sinks();
+    static void flush();
+
+    [[nodiscard]] static uint64_t get_dropped_count();
+
+    [[nodiscard]] static LogSink stderr_sink();
+    [[nodiscard]] static LogSink file_sink(const std::string& path);
+
+private:
+    static bool admit(LogLevel level, const char* format, uint32_t& suppressed);
+    static void submit(const LogRecord& record);
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Process;
+
+struct ModuleEntry {
+    uint64_t base = 0;
+    uint32_t size = 0;
+    std::string name;
+    std::string path;
+};
+
+enum class ModuleEventType {
+    loaded,
+    unloaded,
+};
+
+struct ModuleEvent {
+    ModuleEventType type;
+    ModuleEntry module;
+};
+
+// Tracks the module list of a process. poll() compares the current module map to the
+// previous one by base and size only, so names are copied for loaded modules alone.
+// Export tables are built on the first get_proc_address() call for a module and dropped
+// when it unloads.
+class ModuleWatcher {
+public:
+    using Callback = std::function<void(const ModuleEvent&)>;
+
+    explicit ModuleWatcher(const Process& process, Callback callback = {});
+
+    bool poll();
+
+    [[nodiscard]] const ModuleEntry* find(std::string_view module_name) const;
+    [[nodiscard]] uint64_t get_proc_address(std::string_view module_name, std::string_view function_name);
+    [[nodiscard]] size_t size() const { return modules.size(); }
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const;
+    };
+
+    struct NameEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const;
+    };
+
+    using StringMap = std::unordered_map<std::string, uint64_t, StringHash, std::equal_to<>>;
+    using NameMap = std::unordered_map<std::string, uint64_t, NameHash, NameEqual>;
+
+    struct Module {
+        ModuleEntry entry;
+        std::unique_ptr<StringMap> exports;
+    };
+
+    struct Span {
+        uint64_t base;
+        uint32_t size;
+        uint32_t index;
+    };
+
+    const Process& process;
+    Callback callback;
+
+    std::vector<Span> spans;
+    std::vector<Span> current_spans;
+    std::unordered_map<uint64_t, Module> modules;
+    NameMap name_index;
+
+    Module* find_module(std::string_view module_name);
+    bool build_exports(Module& module) const;
+    void insert(ModuleEntry entry);
+    void erase(uint64_t base);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Process;
+
+struct PointerScanOptions {
+    size_t max_depth = 5;
+    uint64_t max_offset = 0x1000;
+    size_t max_results = 10000;
+    size_t threads = 4;
+    size_t chunk_size = 0x400000;
+    bool include_heaps = true;
+};
+
+struct PointerPath {
+    std::string module_name;
+    uint64_t module_offset = 0;
+    std::vector<uint64_t> offsets;
+
+    // Offsets for Process::read_chain, starting from the module base address.
+    [[nodiscard]] std::vector<uint64_t> get_chain() const;
+};
+
+// Finds module-relative pointer chains that lead to a target address. snapshot() captures
+// every pointer-sized value that points into mapped memory, indexed by the value it holds;
+// find_paths() then walks that index backwards from the target on a work-stealing pool.
+class PointerScanner {
+public:
+    explicit PointerScanner(const Process& process, PointerScanOptions options = {});
+
+    bool snapshot();
+    [[nodiscard]] std::vector<PointerPath> find_paths(uint64_t target) const;
+    [[nodiscard]] size_t get_pointer_count() const { return records.size(); }
+
+private:
+    struct PointerRecord {
+        uint64_t value;
+        uint64_t location;
+    };
+
+    struct Range {
+        uint64_t begin;
+        uint64_t end;
+        uint32_t module_index;
+    };
+
+    const Process& process;
+    const PointerScanOptions options;
+
+    std::vector<PointerRecord> records;
+    std::vector<Range> static_ranges;
+    std::vector<Range> mapped_ranges;
+    std::vector<std::string> module_names;
+    std::vector<uint64_t> module_bases;
+
+    [[nodiscard]] const Range* find_range(const std::vector<Range>& ranges, uint64_t address) const;
+    void collect_module_ranges(std::vector<Range>& scan_ranges);
+    void collect_pointers(const Range& range, std::vector<PointerRecord>& out) const;
+};
@@ -1,32 +1,67 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "include/VolkDMA/coroutine.hh"
+#include "include/VolkDMA/rangeread.hh"
+#include "include/VolkDMA/scatter.hh"
+#include "include/VolkDMA/status.hh"
+
 class DMA;
 using VMMDLL_SCATTER_HANDLE = void*;
 using DWORD = unsigned long;
 
+// Thread model: every const member is safe to call concurrently from any number of
+// threads. Scatter batches should be built through acquire_scatter(), which leases a
+// pooled handle to the calling thread without touching shared state per entry. The raw
+// scatter handle API is kept for compatibility and serializes on an internal lock.
+// fix_cr3() reconfigures the process and must not run concurrently with other calls.
+//
+// The try_* functions never log or allocate on the C++ heap; they return a VolkStatus
+// instead and bump the failure counter, which makes them suitable for per-frame polling.
+// try_get_base_address() still has vmm.dll allocate and free a module map entry per call,
+// so cache its result rather than polling it.
 class Process {
 public:
     Process(DMA& dma, const std::string& process_name);
-    [[nodiscard]] uint64_t get_base_address(const std::string& module_name) const;
-    [[nodiscard]] size_t get_size(const std::string& module_name) const;
-    bool dump_module(const std::string& module_name, const std::string& path) const;
-    [[nodiscard]] std::string get_path(const std::string& module_name) const;
+    ~Process();
+
+    Process(const Process&) = delete;
+    Process& operator=(const Process&) = delete;
+
+    [[nodiscard]] uint64_t get_base_address(std::string_view module_name) const;
+    [[nodiscard]] VolkResult<uint64_t> try_get_base_address(std::string_view module_name) const;
+    [[nodiscard]] size_t get_size(std::string_view module_name) const;
+    bool dump_module(std::string_view module_name, const std::string& path) const;
+    [[nodiscard]] std::string get_path(std::string_view module_name) const;
     [[nodiscard]] std::vector<std::string> get_modules(DWORD process_id = 0) const;
     bool fix_cr3(const std::string& process_name);
     [[nodiscard]] constexpr bool is_valid_address(const uint64_t address) const { return address >= 0x1000; }
     bool virtual_to_physical(uint64_t virtual_address, uint64_t& physical_address) const;
     bool read(uint64_t address, void* buffer, size_t size) const;
+    [[nodiscard]] VolkStatus try_read(uint64_t address, void* buffer, size_t size) const;
+    VolkStatus read_range(uint64_t address, size_t size, RangeRead& range, uint32_t retries = 0) const;
     [[nodiscard]] uint64_t read_chain(uint64_t base, const std::vector<uint64_t>& offsets) const;
+    [[nodiscard]] uint64_t read_chain(uint64_t base, std::span<const uint64_t> offsets) const;
+    [[nodiscard]] VolkResult<uint64_t> try_read_chain(uint64_t base, std::span<const uint64_t> offsets) const;
     bool write(uint64_t address, void* buffer, size_t size, DWORD process_id = 0) const;
+    [[nodiscard]] VolkStatus try_write(uint64_t address, const void* buffer, size_t size, DWORD process_id = 0) const;
     [[nodiscard]] VMMDLL_SCATTER_HANDLE create_scatter(DWORD process_id = 0) const;
     void close_scatter(VMMDLL_SCATTER_HANDLE scatter_handle) const;
     bool add_read_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, uint64_t address, void* buffer, size_t size) const;
     bool add_write_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, uint64_t address, void* buffer, size_t size) const;
     bool execute_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id = 0) const;
+    [[nodiscard]] ScatterContext acquire_scatter(DWORD process_id = 0) const;
+    [[nodiscard]] DWORD get_process_id() const { return process_id; }
+    [[nodiscard]] const DMA& get_dma() const { return dma; }
+    [[nodiscard]] uint64_t get_failure_count() const { return failure_count.load(std::memory_order_relaxed); }
+    [[nodiscard]] ScatterTuner& get_scatter_tuner() const { return scatter_tuner; }
 
     template <typename T>
     [[nodiscard]] T read(uint64_t address) const {
@@ -35,15 +70,56 @@ public:
         return buffer;
     }
 
+    template <typename T>
+    [[nodiscard]] VolkResult<T> try_read(uint64_t address) const {
+        VolkResult<T> result{};
+        result.status = this->try_read(address, &result.value, sizeof(T));
+        return result;
+    }
+
+    // Awaitable from a ReadTask; the read is batched with every other pending read on the
+    // next ReadExecutor::tick().
+    template <typename T>
+    [[nodiscard]] ReadAwaitable<T> read_async(uint64_t address) const {
+        return ReadAwaitable<T>(this, address, this->is_valid_address(address));
+    }
+
+    // The typed chains dereference base + offsets[0] and every following offset but the last,
+    // then read T at the last pointer plus offsets.back(). With a single offset that offset is
+    // used twice: T is read at read<uint64_t>(base + offsets[0]) + offsets[0].
     template <typename T>
     [[nodiscard]] T read_chain(uint64_t base, const std::vector<uint64_t>& offsets) const {
-        uint64_t result = this->read<uint64_t>(base + offsets.at(0));
+        return this->read_chain<T>(base, std::span<const uint64_t>(offsets));
+    }
+
+    template <typename T>
+    [[nodiscard]] T read_chain(uint64_t base, std::span<const uint64_t> offsets) const {
+        if (offsets.empty()) {
+            return T{};
+        }
+
+        uint64_t result = this->read<uint64_t>(base + offsets[0]);
         for (size_t i = 1; i < offsets.size() - 1; ++i) {
-            result = this->read<uint64_t>(result + offsets.at(i));
+            result = this->read<uint64_t>(result + offsets[i]);
         }
         return this->read<T>(result + offsets.back());
     }
 
+    template <typename T>
+    [[nodiscard]] VolkResult<T> try_read_chain(uint64_t base, std::span<const uint64_t> offsets) const {
+        if (offsets.empty()) {
+            this->failure_count.fetch_add(1, std::memory_order_relaxed);
+            return { T{}, VolkStatus::invalid_argument };
+        }
+
+        VolkResult<uint64_t> pointer = this->try_read_chain(base, offsets.first(offsets.size() > 1 ? offsets.size() - 1 : 1));
+        if (!pointer) {
+            return { T{}, pointer.status };
+        }
+
+        return this->try_read<T>(pointer.value + offsets.back());
+    }
+
     template <typename T>
     bool write(uint64_t address, T value, DWORD process_id = 0) const {
         return this->write(address, &value, sizeof(T), process_id);
@@ -60,8 +136,21 @@ public:
     }
 
 private:
+    friend class ScatterContext;
+
     const DMA& dma;
     const DWORD process_id;
-    
+
+    mutable std::mutex scatter_counts_mutex;
     mutable std::unordered_map<VMMDLL_SCATTER_HANDLE, int> scatter_counts;
+
+    mutable std::atomic<uint64_t> failure_count{ 0 };
+
+    mutable ScatterTuner scatter_tuner;
+
+    mutable std::mutex scatter_pool_mutex;
+    mutable std::vector<VMMDLL_SCATTER_HANDLE> scatter_pool;
+
+    bool flush_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id) const;
+    void release_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id, bool pending) const;
 };
\ No newline at end of file
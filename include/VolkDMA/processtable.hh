@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class DMA;
+
+using DWORD = unsigned long;
+
+struct ProcessEntry {
+    DWORD process_id = 0;
+    DWORD parent_process_id = 0;
+    uint64_t eprocess = 0;
+    uint64_t create_time = 0;
+    std::string name;
+};
+
+enum class ProcessEventType {
+    started,
+    exited,
+};
+
+struct ProcessEvent {
+    ProcessEventType type;
+    ProcessEntry process;
+};
+
+// Cached process table. refresh() diffs the current PID list against the previous one and
+// only queries details for new PIDs. Surviving PIDs are checked with one batched read of
+// EPROCESS.CreateTime and only re-queried when it changed, so a reused PID shows up as an
+// exit followed by a start. The first refresh reports every running process as started.
+// Names are indexed case-insensitively.
+class ProcessTable {
+public:
+    explicit ProcessTable(const DMA& dma);
+
+    bool refresh(std::vector<ProcessEvent>* events = nullptr);
+
+    [[nodiscard]] DWORD get_process_id(std::string_view process_name) const;
+    [[nodiscard]] std::vector<DWORD> get_process_id_list(std::string_view process_name) const;
+    [[nodiscard]] const ProcessEntry* find(DWORD process_id) const;
+    [[nodiscard]] bool is_alive(DWORD process_id, uint64_t eprocess = 0) const;
+    [[nodiscard]] size_t size() const { return entries.size(); }
+
+private:
+    const DMA& dma;
+
+    std::vector<DWORD> process_ids;
+    std::vector<DWORD> current_ids;
+    std::vector<DWORD> survivors;
+    std::vector<ProcessEntry> started;
+    std::vector<ProcessEntry> replaced;
+    std::vector<uint64_t> create_time_addresses;
+    std::vector<uint64_t> create_times;
+    std::unordered_map<DWORD, ProcessEntry> entries;
+    std::unordered_multimap<std::string, DWORD> name_index;
+
+    uint32_t create_time_offset = 0;
+    bool create_time_resolved = false;
+
+    bool query(DWORD process_id, ProcessEntry& entry) const;
+    void read_create_times();
+    void insert(ProcessEntry entry, std::vector<ProcessEvent>* events);
+    void erase(DWORD process_id, std::vector<ProcessEvent>* events);
+};
+
+class ProcessWatcher {
+public:
+    using Callback = std::function<void(const ProcessEvent&)>;
+
+    ProcessWatcher(const DMA& dma, Callback callback, std::string process_name = {});
+
+    bool poll();
+    [[nodiscard]] const ProcessTable& get_table() const { return table; }
+
+private:
+    ProcessTable table;
+    Callback callback;
+    std::string process_name;
+    std::vector<ProcessEvent> events;
+};
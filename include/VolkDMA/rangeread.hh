@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Result of Process::read_range. data covers the requested range; pages that could not
+// be read are zero-filled and have their bit cleared in the validity bitmap. Page
+// indices count from the page containing address, so the first and last page can be
+// partial.
+struct RangeRead {
+    static constexpr size_t page_size = 0x1000;
+
+    uint64_t address = 0;
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> valid_pages;
+    size_t page_count = 0;
+    size_t valid_count = 0;
+
+    [[nodiscard]] bool is_complete() const { return valid_count == page_count; }
+
+    [[nodiscard]] bool is_page_valid(size_t page) const {
+        return page < page_count && (valid_pages[page / 64] >> (page % 64) & 1) != 0;
+    }
+
+    // True when every page overlapping [range_address, range_address + size) was read.
+    [[nodiscard]] bool is_valid(uint64_t range_address, size_t size) const {
+        if (size == 0 || range_address < address || range_address + size > address + data.size()) {
+            return false;
+        }
+
+        const uint64_t first_page = address & ~(page_size - 1);
+        for (uint64_t page = (range_address & ~(page_size - 1)); page < range_address + size; page += page_size) {
+            if (!is_page_valid(static_cast<size_t>((page - first_page) / page_size))) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class Process;
+
+enum class ScanCompare {
+    exact,
+    range,
+    changed,
+    unchanged,
+    increased,
+    decreased,
+};
+
+struct ScanOptions {
+    size_t chunk_size = 0x400000;
+    size_t alignment = 0;
+    size_t threads = 4;
+    bool include_images = true;
+};
+
+// Scans the committed memory of a process for typed values. The first scan streams every
+// region in chunk_size pieces; later scans only re-read the pages that still hold
+// candidates. Chunks are processed in parallel, one scatter context per worker.
+template <typename T>
+class ValueScanner {
+public:
+    explicit ValueScanner(const Process& process, ScanOptions options = {});
+
+    size_t first_scan(ScanCompare compare, T value, T upper = T{});
+    size_t next_scan(ScanCompare compare, T value = T{}, T upper = T{});
+    void reset();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] std::vector<uint64_t> get_addresses(size_t limit = (std::numeric_limits<size_t>::max)()) const;
+
+private:
+    struct Chunk {
+        uint64_t base = 0;
+        uint64_t size = 0;
+        size_t count = 0;
+        std::vector<uint32_t> offsets;
+        std::vector<uint64_t> bitmap;
+        std::vector<T> values;
+    };
+
+    const Process& process;
+    const ScanOptions options;
+    const size_t alignment;
+
+    std::vector<Chunk> chunks;
+
+    [[nodiscard]] std::vector<Chunk> enumerate_chunks() const;
+    void run_parallel(size_t count, void (ValueScanner::*work)(Chunk&, ScanCompare, T, T) const, ScanCompare compare, T value, T upper);
+    void scan_chunk(Chunk& chunk, ScanCompare compare, T value, T upper) const;
+    void rescan_chunk(Chunk& chunk, ScanCompare compare, T value, T upper) const;
+    void compact(Chunk& chunk, std::vector<uint32_t>& offsets) const;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+class Process;
+using VMMDLL_SCATTER_HANDLE = void*;
+using DWORD = unsigned long;
+
+// max_entries = 0 never splits a batch.
+struct ScatterTuning {
+    size_t max_entries = 1024;
+    size_t concurrency = 1;
+};
+
+// Online cost model for scatter execution, shared by every context of a Process. Each
+// full-size sub-batch updates an EWMA of the cost per entry for its size bucket, and each
+// split batch updates the caller stall per entry for the concurrency it used. New batches
+// take the cheapest known parameters, occasionally probing a neighbour so the model keeps
+// tracking the device. Only contexts that call enable_tuning() consult or feed the model.
+// set_fixed() pins the parameters, e.g. for benchmarking. All state is atomic; concurrent
+// updates may interleave, which only blurs the averages.
+class ScatterTuner {
+public:
+    static constexpr size_t min_entries_shift = 6;
+    static constexpr size_t bucket_count = 8;
+    static constexpr std::array<size_t, 3> concurrency_levels = { 1, 2, 4 };
+
+    [[nodiscard]] ScatterTuning get_tuning() const;
+    [[nodiscard]] bool is_fixed() const;
+    [[nodiscard]] double get_entry_cost(size_t max_entries) const;
+    void set_fixed(ScatterTuning tuning);
+    void clear_fixed();
+
+private:
+    friend class ScatterContext;
+
+    struct Estimate {
+        std::atomic<double> cost{ 0.0 };
+        std::atomic<uint64_t> samples{ 0 };
+    };
+
+    // Tunings are packed as max_entries << 8 | concurrency so they load and store as one.
+    std::atomic<bool> fixed{ false };
+    std::atomic<uint64_t> fixed_tuning{ pack(ScatterTuning{}) };
+    std::atomic<uint64_t> best_tuning{ pack(ScatterTuning{}) };
+    std::atomic<uint64_t> plans{ 0 };
+    std::array<Estimate, bucket_count> batch_costs{};
+    std::array<Estimate, concurrency_levels.size()> stall_costs{};
+
+    static constexpr uint64_t pack(ScatterTuning tuning) { return static_cast<uint64_t>(tuning.max_entries) << 8 | (tuning.concurrency & 0xFF); }
+    static constexpr ScatterTuning unpack(uint64_t packed) { return { static_cast<size_t>(packed >> 8), static_cast<size_t>(packed & 0xFF) }; }
+
+    ScatterTuning plan();
+    void record_batch(size_t entries, std::chrono::nanoseconds latency);
+    void record_stall(size_t concurrency, size_t entries, std::chrono::nanoseconds stall);
+    void update_best();
+};
+
+// A scatter handle leased from a Process pool. A context is owned by one thread at a
+// time and returns its handle to the pool when destroyed. By default every execute() is
+// one round trip. A context with a tuning executes batches larger than its max_entries in
+// pieces while they are built; with concurrency above one, full pieces run on extra pooled
+// handles on a shared worker pool until execute() joins them.
+class ScatterContext {
+public:
+    ScatterContext() = default;
+    ~ScatterContext();
+
+    ScatterContext(const ScatterContext&) = delete;
+    ScatterContext& operator=(const ScatterContext&) = delete;
+
+    ScatterContext(ScatterContext&& other) noexcept;
+    ScatterContext& operator=(ScatterContext&& other) noexcept;
+
+    bool add_read(uint64_t address, void* buffer, size_t size, DWORD* bytes_read = nullptr);
+    bool add_write(uint64_t address, void* buffer, size_t size);
+    bool execute();
+    void reset();
+
+    // Takes the batch parameters from the Process tuner until reset(), including its
+    // occasional probes, and feeds it the measured latencies.
+    void enable_tuning();
+    // Uses a fixed tuning until reset(); the default is { 0, 1 }. Not sampled by the tuner.
+    void pin_tuning(ScatterTuning pinned_tuning);
+
+    [[nodiscard]] size_t size() const { return total_entries; }
+    [[nodiscard]] VMMDLL_SCATTER_HANDLE get() const { return handle; }
+    explicit operator bool() const { return handle != nullptr; }
+
+    template <typename T>
+    bool add_read(uint64_t address, T* buffer) {
+        return this->add_read(address, reinterpret_cast<void*>(buffer), sizeof(T));
+    }
+
+    template <typename T>
+    bool add_write(uint64_t address, const T& value) {
+        return this->add_write(address, reinterpret_cast<void*>(const_cast<T*>(&value)), sizeof(T));
+    }
+
+private:
+    friend class Process;
+    ScatterContext(const Process* process, VMMDLL_SCATTER_HANDLE handle, DWORD process_id);
+
+    struct InFlight {
+        VMMDLL_SCATTER_HANDLE handle;
+        std::future<bool> result;
+    };
+
+    const Process* process = nullptr;
+    VMMDLL_SCATTER_HANDLE handle = nullptr;
+    DWORD process_id = 0;
+    size_t entries = 0;
+    size_t total_entries = 0;
+    bool success = true;
+    bool tuned = false;
+    ScatterTuning tuning{ 0, 1 };
+    std::chrono::nanoseconds stall{ 0 };
+    std::vector<InFlight> in_flight;
+
+    bool prepare();
+    void dispatch();
+    static bool run_batch(const Process* process, VMMDLL_SCATTER_HANDLE batch_handle, DWORD process_id, size_t batch_entries, bool sample);
+    bool join();
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Process;
+using DWORD = unsigned long;
+
+enum class ReadPriority : uint8_t {
+    critical,
+    high,
+    normal,
+    low,
+};
+
+enum class ReadState : uint8_t {
+    pending,
+    done,
+    failed,
+    dropped,
+    expired,
+};
+
+struct ScheduledRead {
+    uint64_t address = 0;
+    void* buffer = nullptr;
+    size_t size = 0;
+    ReadPriority priority = ReadPriority::normal;
+    std::chrono::steady_clock::time_point deadline = (std::chrono::steady_clock::time_point::max)();
+    ReadState* state = nullptr;
+};
+
+struct ReadBudget {
+    size_t max_round_trips = 2;
+    size_t entries_per_round_trip = 512;
+    size_t max_bytes = 0x40000;
+    uint32_t max_deferrals = 8;
+};
+
+struct ReadSchedulerStats {
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t starved = 0;
+    uint64_t dropped = 0;
+    uint64_t expired = 0;
+    uint64_t late = 0;
+    uint64_t round_trips = 0;
+    uint64_t bytes = 0;
+};
+
+// Per-frame read scheduler. run_frame() first expires requests whose deadline passed,
+// then fills up to max_round_trips scatter batches and max_bytes from the highest
+// priority down, earliest deadline first within a priority. Each batch executes in exactly
+// one round trip, and no lower priority is filled once a higher one had to leave a request
+// out. Requests that do not fit are deferred to the next frame and counted as starved;
+// non-critical requests deferred more than max_deferrals times are dropped. Reads larger
+// than max_bytes are rejected. A scheduler is meant to be driven by one thread.
+class ReadScheduler {
+public:
+    explicit ReadScheduler(const Process& process, ReadBudget budget = {});
+
+    bool submit(const ScheduledRead& read);
+    ReadSchedulerStats run_frame();
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] const ReadSchedulerStats& get_stats() const { return stats; }
+    [[nodiscard]] const ReadBudget& get_budget() const { return budget; }
+    void set_budget(const ReadBudget& new_budget) { budget = new_budget; }
+
+private:
+    struct Pending {
+        ScheduledRead read;
+        uint32_t deferrals;
+    };
+
+    static constexpr size_t priority_count = 4;
+
+    const Process& process;
+    ReadBudget budget;
+    ReadSchedulerStats stats{};
+
+    std::array<std::vector<Pending>, priority_count> queues;
+    std::vector<Pending> batch;
+    std::vector<DWORD> bytes_read;
+
+    void finish(const Pending& pending, ReadState state) const;
+};
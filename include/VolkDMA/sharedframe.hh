@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+struct SharedFrameHeader;
+struct SharedFrameSlot;
+
+struct FrameView {
+    uint64_t frame = 0;
+    uint64_t sequence = 0;
+    size_t slot = 0;
+    std::span<const uint8_t> data;
+};
+
+// Publishes polled frames into a named shared-memory ring so other local processes can
+// consume them without opening their own DMA handle. Every slot is a seqlock: the
+// publisher makes its sequence odd while writing and even again on commit. One thread of
+// one process may publish: the publisher holds a named owner mutex for its lifetime, so a
+// second publisher for the same name fails until the first is destroyed or has crashed.
+// The mutex belongs to the constructing thread, which must also publish and destroy it.
+// Scatter reads can target the span from begin_frame() directly.
+class FramePublisher {
+public:
+    FramePublisher(std::string_view name, size_t frame_size, size_t slot_count = 4);
+    ~FramePublisher();
+
+    FramePublisher(const FramePublisher&) = delete;
+    FramePublisher& operator=(const FramePublisher&) = delete;
+
+    [[nodiscard]] std::span<uint8_t> begin_frame();
+    bool commit_frame(size_t size);
+    bool publish(std::span<const uint8_t> data);
+
+    [[nodiscard]] uint64_t get_frame_count() const { return frame_count; }
+    [[nodiscard]] size_t get_frame_size() const { return frame_size; }
+    explicit operator bool() const { return header != nullptr; }
+
+private:
+    void* owner = nullptr;
+    void* mapping = nullptr;
+    SharedFrameHeader* header = nullptr;
+    size_t frame_size = 0;
+    size_t slot_count = 0;
+    uint64_t frame_count = 0;
+    SharedFrameSlot* writing = nullptr;
+};
+
+// Read side of a FramePublisher ring. view_latest() hands out a zero-copy view into the
+// mapping; the data may be overwritten while it is being used, so check is_current()
+// after consuming it and discard the result if it returns false. read_latest() does the
+// copy and retry itself.
+class FrameSubscriber {
+public:
+    explicit FrameSubscriber(std::string_view name);
+    ~FrameSubscriber();
+
+    FrameSubscriber(const FrameSubscriber&) = delete;
+    FrameSubscriber& operator=(const FrameSubscriber&) = delete;
+
+    [[nodiscard]] bool view_latest(FrameView& view) const;
+    [[nodiscard]] bool is_current(const FrameView& view) const;
+    bool read_latest(std::vector<uint8_t>& out, uint64_t* frame = nullptr) const;
+
+    [[nodiscard]] uint64_t get_frame_count() const;
+    [[nodiscard]] size_t get_frame_size() const { return frame_size; }
+    explicit operator bool() const { return header != nullptr; }
+
+private:
+    void* mapping = nullptr;
+    const SharedFrameHeader* header = nullptr;
+    size_t frame_size = 0;
+    size_t slot_count = 0;
+
+    const SharedFrameSlot* get_slot(size_t index) const;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+enum class VolkStatus : uint8_t {
+    ok,
+    invalid_address,
+    invalid_argument,
+    partial_read,
+    read_failed,
+    write_failed,
+    not_found,
+};
+
+// Value plus status returned by the non-logging try_* APIs.
+template <typename T>
+struct VolkResult {
+    T value{};
+    VolkStatus status = VolkStatus::ok;
+
+    explicit operator bool() const { return status == VolkStatus::ok; }
+};
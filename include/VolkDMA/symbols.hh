@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+class DMA;
+
+using DWORD = unsigned long;
+
+// Resolves symbols and struct field offsets from module PDBs and caches every result
+// on disk per module identity (PDB name, GUID and age). Symbol addresses are cached as
+// RVAs and rebased on the module's current base, so a cache hit only costs the module
+// lookup. Not synchronized.
+//
+// The cache is a tab-separated text file (identity, key, hex value per line) that lives
+// under %LOCALAPPDATA%\VolkDMA unless another path is given.
+class SymbolResolver {
+public:
+    explicit SymbolResolver(const DMA& dma, std::filesystem::path cache_path = get_default_cache_path());
+    ~SymbolResolver();
+
+    SymbolResolver(const SymbolResolver&) = delete;
+    SymbolResolver& operator=(const SymbolResolver&) = delete;
+
+    [[nodiscard]] uint64_t get_symbol_address(DWORD process_id, const std::string& module_name, const std::string& symbol_name);
+    bool get_type_offset(DWORD process_id, const std::string& module_name, const std::string& type_name, const std::string& field_name, uint32_t& offset);
+
+    bool get_cached_value(DWORD process_id, const std::string& module_name, const std::string& key, uint64_t& value);
+    void store_cached_value(DWORD process_id, const std::string& module_name, const std::string& key, uint64_t value);
+    void store_symbol_address(DWORD process_id, const std::string& module_name, const std::string& symbol_name, uint64_t address);
+
+    bool save();
+
+    [[nodiscard]] static std::filesystem::path get_default_cache_path();
+
+private:
+    struct ModuleIdentity {
+        std::string key;
+        uint64_t base = 0;
+        uint32_t image_size = 0;
+        std::string pdb_module;
+        bool pdb_attempted = false;
+    };
+
+    const DMA& dma;
+    const std::filesystem::path cache_path;
+
+    std::unordered_map<std::string, ModuleIdentity> identities;
+    std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>> cache;
+    bool dirty = false;
+
+    ModuleIdentity* identify(DWORD process_id, const std::string& module_name);
+    bool load_pdb(DWORD process_id, ModuleIdentity& identity);
+    void load();
+};
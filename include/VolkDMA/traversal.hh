@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "include/VolkDMA/process.hh"
+
+struct TraversalLimits {
+    size_t max_elements = 0x10000;
+    size_t chunk_size = 0x1000;
+    size_t max_prefetch = 256;
+};
+
+class Traversal {
+public:
+    explicit Traversal(const Process& process, TraversalLimits limits = {});
+
+    bool read_pointer_array(uint64_t address, size_t count, std::vector<uint64_t>& pointers) const;
+    bool walk_list(uint64_t list_head, std::vector<uint64_t>& entries, uint64_t entry_offset = 0) const;
+    bool walk_tree(uint64_t root, std::span<const uint64_t> child_offsets, std::vector<uint64_t>& nodes, uint64_t sentinel = 0) const;
+
+    template <typename T>
+    bool read_objects(std::span<const uint64_t> addresses, std::vector<T>& objects) const {
+        objects.assign(addresses.size(), T{});
+        if (addresses.empty()) {
+            return true;
+        }
+
+        ScatterContext scatter = this->process.acquire_scatter();
+        if (!scatter) {
+            return false;
+        }
+
+        bool success = true;
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            if (this->process.is_valid_address(addresses[i])) {
+                success &= scatter.add_read(addresses[i], &objects[i]);
+            }
+        }
+
+        success &= scatter.execute();
+        return success;
+    }
+
+    template <typename T>
+    bool read_pointed_objects(uint64_t array_address, size_t count, std::vector<T>& objects) const {
+        std::vector<uint64_t> pointers;
+        const bool success = this->read_pointer_array(array_address, count, pointers);
+        return this->read_objects(pointers, objects) && success;
+    }
+
+private:
+    const Process& process;
+    const TraversalLimits limits;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class Process;
+
+struct WriteQueuePolicy {
+    size_t max_bytes = 0x10000;
+    size_t max_ranges = 512;
+    std::chrono::microseconds max_delay{ 0 };
+};
+
+// bytes_committed and bytes_failed count pushed bytes by how their flush ended; writes that
+// are still pending or were discarded are in neither. bytes_saved() only covers flushes
+// that succeeded.
+struct WriteQueueStats {
+    uint64_t writes_queued = 0;
+    uint64_t bytes_queued = 0;
+    uint64_t bytes_committed = 0;
+    uint64_t bytes_failed = 0;
+    uint64_t bytes_written = 0;
+    uint64_t ranges_written = 0;
+    uint64_t flushes = 0;
+    uint64_t failed_flushes = 0;
+
+    [[nodiscard]] uint64_t bytes_saved() const { return bytes_committed - bytes_written; }
+};
+
+// Collects writes and keeps only the final value of every byte, merging touching ranges.
+// Pending writes go out as one scatter on commit() or once a policy threshold is hit.
+// Thresholds are only checked in push() and poll(), so a queue with a max_delay must be
+// polled every frame for the deadline to apply. A queue is not synchronized; use one per
+// thread.
+class WriteQueue {
+public:
+    explicit WriteQueue(const Process& process, WriteQueuePolicy policy = {});
+    ~WriteQueue();
+
+    WriteQueue(const WriteQueue&) = delete;
+    WriteQueue& operator=(const WriteQueue&) = delete;
+
+    bool push(uint64_t address, const void* buffer, size_t size);
+    bool commit();
+    // Flushes when a threshold, including max_delay, has been reached. Call once per frame.
+    bool poll();
+    void discard();
+
+    [[nodiscard]] size_t pending_bytes() const { return queued_bytes; }
+    [[nodiscard]] size_t pending_ranges() const { return ranges.size(); }
+    [[nodiscard]] const WriteQueueStats& get_stats() const { return stats; }
+    void reset_stats() { stats = {}; }
+
+    template <typename T>
+    bool push(uint64_t address, const T& value) {
+        return this->push(address, &value, sizeof(T));
+    }
+
+private:
+    const Process& process;
+    const WriteQueuePolicy policy;
+
+    std::map<uint64_t, std::vector<uint8_t>> ranges;
+    size_t queued_bytes = 0;
+    size_t pushed_bytes = 0;
+    std::chrono::steady_clock::time_point oldest_write{};
+    WriteQueueStats stats{};
+
+    [[nodiscard]] bool should_flush() const;
+};
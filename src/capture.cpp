@@ -0,0 +1,391 @@
+#include "include/VolkDMA/capture.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <emmintrin.h>
+
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+static constexpr uint32_t capture_magic = 0x53434B56; // "VKCS"
+static constexpr uint32_t capture_version = 2;
+static constexpr size_t record_header_size = 13;
+static constexpr size_t min_skip = 8;
+
+enum class CaptureRecord : uint8_t {
+    keyframe,
+    delta,
+};
+
+template <typename T>
+static void put(std::vector<uint8_t>& out, T value) {
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+static bool get(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+static void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static bool get_varint(const uint8_t*& it, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; it != end && shift < 64; shift += 7) {
+        const uint8_t byte = *it++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Length of the common prefix of a and b, sixteen bytes per compare.
+static size_t equal_prefix(const uint8_t* a, const uint8_t* b, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+        if (mask != 0xFFFF) {
+            return i + static_cast<size_t>(std::countr_one(mask));
+        }
+    }
+
+    while (i < size && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+static void xor_into(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(lhs, rhs));
+    }
+
+    for (; i < size; ++i) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+// Appends (skip, length, xor bytes) runs describing current ^ previous. Equal runs shorter
+// than min_skip stay inside the literal, where they cost less than a new run header.
+static void encode_delta(const uint8_t* current, const uint8_t* previous, size_t size, std::vector<uint8_t>& out) {
+    size_t position = 0;
+    while (position < size) {
+        const size_t skip = equal_prefix(current + position, previous + position, size - position);
+        if (position + skip == size) {
+            break;
+        }
+
+        const size_t literal_start = position + skip;
+        size_t literal_end = literal_start + 1;
+        while (literal_end < size) {
+            const size_t run = equal_prefix(current + literal_end, previous + literal_end, size - literal_end);
+            if (run >= min_skip || literal_end + run == size) {
+                break;
+            }
+            literal_end += run + 1;
+        }
+        literal_end = std::min(literal_end, size);
+
+        put_varint(out, skip);
+        put_varint(out, literal_end - literal_start);
+
+        const size_t offset = out.size();
+        out.resize(offset + (literal_end - literal_start));
+        xor_into(out.data() + offset, current + literal_start, previous + literal_start, literal_end - literal_start);
+
+        position = literal_end;
+    }
+}
+
+static bool decode_delta(const uint8_t* it, const uint8_t* end, uint8_t* state, size_t size) {
+    size_t position = 0;
+    while (it != end) {
+        uint64_t skip = 0;
+        uint64_t length = 0;
+        if (!get_varint(it, end, skip) || !get_varint(it, end, length)) {
+            return false;
+        }
+
+        if (skip > size - position || length > size - position - skip || length > static_cast<size_t>(end - it)) {
+            return false;
+        }
+
+        position += skip;
+        xor_into(state + position, state + position, it, length);
+        position += length;
+        it += length;
+    }
+    return true;
+}
+
+CaptureWriter::CaptureWriter(const Process& process, const std::filesystem::path& path, std::vector<CaptureRegion> regions, uint32_t keyframe_interval)
+    : process(process), regions(std::move(regions)), keyframe_interval(keyframe_interval), start(std::chrono::steady_clock::now()) {
+    for (const CaptureRegion& region : this->regions) {
+        this->frame_size += region.size;
+    }
+
+    if (this->frame_size == 0) {
+        Log::error("[CAPTURE] No regions to capture.");
+        return;
+    }
+
+    this->file.open(path, std::ios::binary | std::ios::trunc);
+    if (!this->file) {
+        Log::error("[CAPTURE] Failed to open {}.", path.string());
+        return;
+    }
+
+    std::vector<uint8_t> header;
+    put(header, capture_magic);
+    put(header, capture_version);
+    put(header, static_cast<uint32_t>(this->regions.size()));
+    for (const CaptureRegion& region : this->regions) {
+        put(header, region.address);
+        put(header, static_cast<uint64_t>(region.size));
+    }
+    this->file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    this->current.resize(this->frame_size);
+    this->previous.resize(this->frame_size);
+    this->valid.resize((this->regions.size() + 7) / 8);
+}
+
+bool CaptureWriter::capture() {
+    if (!*this) {
+        return false;
+    }
+
+    const auto read_start = std::chrono::steady_clock::now();
+    ScatterContext scatter = this->process.acquire_scatter();
+    this->bytes_read.assign(this->regions.size(), 0);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < this->regions.size(); ++i) {
+        scatter.add_read(this->regions[i].address, this->current.data() + offset, this->regions[i].size, &this->bytes_read[i]);
+        offset += this->regions[i].size;
+    }
+    const bool executed = scatter.execute();
+    this->stats.read_time += std::chrono::steady_clock::now() - read_start;
+
+    // Unreadable regions are zeroed rather than left stale, and flagged in the mask.
+    std::fill(this->valid.begin(), this->valid.end(), uint8_t{ 0 });
+    offset = 0;
+    for (size_t i = 0; i < this->regions.size(); ++i) {
+        if (!executed || this->bytes_read[i] != this->regions[i].size) {
+            std::memset(this->current.data() + offset, 0, this->regions[i].size);
+        }
+        else {
+            this->valid[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+        }
+        offset += this->regions[i].size;
+    }
+
+    return this->write_frame(this->current, this->valid);
+}
+
+bool CaptureWriter::write_frame(std::span<const uint8_t> state, std::span<const uint8_t> valid_mask) {
+    if (!*this || state.size() != this->frame_size || (!valid_mask.empty() && valid_mask.size() != this->valid.size())) {
+        return false;
+    }
+
+    const auto encode_start = std::chrono::steady_clock::now();
+    const bool keyframe = this->stats.frames == 0 || (this->keyframe_interval != 0 && this->stats.frames % this->keyframe_interval == 0);
+    if (keyframe) {
+        std::fill(this->previous.begin(), this->previous.end(), uint8_t{ 0 });
+    }
+
+    this->record.clear();
+    put(this->record, keyframe ? CaptureRecord::keyframe : CaptureRecord::delta);
+    put(this->record, uint32_t{ 0 });
+    put(this->record, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(encode_start - this->start).count()));
+
+    if (valid_mask.empty()) {
+        const size_t mask_offset = this->record.size();
+        this->record.resize(mask_offset + this->valid.size(), 0);
+        for (size_t i = 0; i < this->regions.size(); ++i) {
+            this->record[mask_offset + i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+        }
+    }
+    else {
+        this->record.insert(this->record.end(), valid_mask.begin(), valid_mask.end());
+    }
+
+    encode_delta(state.data(), this->previous.data(), this->frame_size, this->record);
+
+    const uint32_t payload_size = static_cast<uint32_t>(this->record.size() - record_header_size);
+    std::memcpy(this->record.data() + 1, &payload_size, sizeof(payload_size));
+    std::memcpy(this->previous.data(), state.data(), this->frame_size);
+
+    this->file.write(reinterpret_cast<const char*>(this->record.data()), static_cast<std::streamsize>(this->record.size()));
+
+    ++this->stats.frames;
+    this->stats.keyframes += keyframe;
+    this->stats.raw_bytes += this->frame_size;
+    this->stats.written_bytes += this->record.size();
+    this->stats.encode_time += std::chrono::steady_clock::now() - encode_start;
+
+    return this->file.good();
+}
+
+void CaptureWriter::flush() {
+    this->file.flush();
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path& path) : file(path, std::ios::binary) {
+    if (!this->file) {
+        Log::error("[CAPTURE] Failed to open {}.", path.string());
+        return;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t region_count = 0;
+    if (!get(this->file, magic) || !get(this->file, version) || !get(this->file, region_count) || magic != capture_magic || version != capture_version) {
+        Log::error("[CAPTURE] {} is not a capture stream.", path.string());
+        this->file.close();
+        return;
+    }
+
+    size_t frame_size = 0;
+    for (uint32_t i = 0; i < region_count; ++i) {
+        uint64_t address = 0;
+        uint64_t size = 0;
+        if (!get(this->file, address) || !get(this->file, size)) {
+            Log::error("[CAPTURE] {} has a truncated region table.", path.string());
+            this->file.close();
+            return;
+        }
+        this->regions.push_back({ address, static_cast<size_t>(size) });
+        frame_size += static_cast<size_t>(size);
+    }
+
+    const uint64_t file_size = std::filesystem::file_size(path);
+    this->mask_size = (region_count + 7) / 8;
+
+    // A stream cut off by a crash ends at the last complete record.
+    for (;;) {
+        const uint64_t offset = static_cast<uint64_t>(this->file.tellg());
+        uint8_t kind = 0;
+        uint32_t size = 0;
+        uint64_t timestamp = 0;
+        if (!get(this->file, kind) || !get(this->file, size) || !get(this->file, timestamp) || offset + record_header_size + size > file_size || size < this->mask_size) {
+            break;
+        }
+
+        const bool keyframe = kind == static_cast<uint8_t>(CaptureRecord::keyframe);
+        if (this->frames.empty() && !keyframe) {
+            break;
+        }
+
+        const size_t mask_offset = this->masks.size();
+        this->masks.resize(mask_offset + this->mask_size);
+        if (!this->file.read(reinterpret_cast<char*>(this->masks.data() + mask_offset), static_cast<std::streamsize>(this->mask_size))) {
+            this->masks.resize(mask_offset);
+            break;
+        }
+
+        if (keyframe) {
+            this->keyframes.push_back(this->frames.size());
+        }
+        this->frames.push_back({ offset, timestamp, size, keyframe });
+        this->file.seekg(size - this->mask_size, std::ios::cur);
+    }
+
+    this->file.clear();
+    this->frame_size = frame_size;
+    this->state.resize(frame_size);
+}
+
+bool CaptureReader::read_frame(size_t index, std::vector<uint8_t>& out) {
+    if (!*this || index >= this->frames.size()) {
+        return false;
+    }
+
+    const auto segment = [this](size_t frame) { return *(std::upper_bound(this->keyframes.begin(), this->keyframes.end(), frame) - 1); };
+    const size_t keyframe = segment(index);
+    const bool in_segment = this->decoded != static_cast<size_t>(-1) && segment(this->decoded) == keyframe;
+
+    if (in_segment && this->decoded > index && this->decoded - index <= index - keyframe) {
+        // Deltas are XORs, so applying frame n's delta to frame n yields frame n - 1.
+        for (; this->decoded > index; --this->decoded) {
+            if (!this->apply(this->decoded)) {
+                this->decoded = static_cast<size_t>(-1);
+                return false;
+            }
+        }
+    }
+    else {
+        size_t next = keyframe;
+        if (in_segment && this->decoded <= index) {
+            next = this->decoded + 1;
+        }
+
+        for (; next <= index; ++next) {
+            if (!this->apply(next)) {
+                this->decoded = static_cast<size_t>(-1);
+                return false;
+            }
+        }
+        this->decoded = index;
+    }
+
+    out.assign(this->state.begin(), this->state.end());
+    return true;
+}
+
+size_t CaptureReader::get_region_offset(size_t region) const {
+    size_t offset = 0;
+    for (size_t i = 0; i < region && i < this->regions.size(); ++i) {
+        offset += this->regions[i].size;
+    }
+    return offset;
+}
+
+bool CaptureReader::is_region_valid(size_t index, size_t region) const {
+    if (index >= this->frames.size() || region >= this->regions.size()) {
+        return false;
+    }
+    return (this->masks[index * this->mask_size + region / 8] >> (region % 8)) & 1;
+}
+
+std::chrono::nanoseconds CaptureReader::get_timestamp(size_t index) const {
+    return index < this->frames.size() ? std::chrono::nanoseconds(this->frames[index].timestamp) : std::chrono::nanoseconds{ 0 };
+}
+
+bool CaptureReader::apply(size_t index) {
+    const FrameRecord& frame = this->frames[index];
+
+    this->record.resize(frame.size);
+    this->file.seekg(static_cast<std::streamoff>(frame.offset + record_header_size));
+    if (!this->file.read(reinterpret_cast<char*>(this->record.data()), frame.size)) {
+        this->file.clear();
+        Log::error("[CAPTURE] Failed to read frame {}.", index);
+        return false;
+    }
+
+    if (frame.keyframe) {
+        std::fill(this->state.begin(), this->state.end(), uint8_t{ 0 });
+    }
+
+    if (!decode_delta(this->record.data() + this->mask_size, this->record.data() + this->record.size(), this->state.data(), this->frame_size)) {
+        Log::error("[CAPTURE] Frame {} is corrupt.", index);
+        return false;
+    }
+    return true;
+}
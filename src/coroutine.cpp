@@ -0,0 +1,99 @@
+#include "include/VolkDMA/coroutine.hh"
+
+#include <algorithm>
+#include <functional>
+
+#include "include/VolkDMA/process.hh"
+
+void ReadTask::promise_type::unhandled_exception() {
+    if (this->executor && !this->executor->exception) {
+        this->executor->exception = std::current_exception();
+    }
+}
+
+ReadExecutor::~ReadExecutor() {
+    for (std::coroutine_handle<ReadTask::promise_type> handle : this->tasks) {
+        handle.destroy();
+    }
+}
+
+void ReadExecutor::spawn(ReadTask task) {
+    std::coroutine_handle<ReadTask::promise_type> handle = std::exchange(task.handle, nullptr);
+    if (!handle) {
+        return;
+    }
+
+    handle.promise().executor = this;
+    handle.promise().index = this->tasks.size();
+    this->tasks.push_back(handle);
+    this->resume(handle);
+
+    if (this->exception) {
+        std::rethrow_exception(std::exchange(this->exception, nullptr));
+    }
+}
+
+size_t ReadExecutor::tick() {
+    if (this->pending.empty()) {
+        return 0;
+    }
+
+    this->batch.swap(this->pending);
+    std::stable_sort(this->batch.begin(), this->batch.end(), [](const PendingRead& a, const PendingRead& b) { return std::less<const Process*>{}(a.process, b.process); });
+
+    for (size_t first = 0; first < this->batch.size();) {
+        const Process* process = this->batch[first].process;
+        size_t last = first;
+        while (last < this->batch.size() && this->batch[last].process == process) {
+            ++last;
+        }
+
+        ScatterContext scatter = process->acquire_scatter();
+        for (size_t i = first; i < last; ++i) {
+            const PendingRead& read = this->batch[i];
+            scatter.add_read(read.address, read.buffer, read.size, read.bytes_read);
+        }
+        if (!scatter.execute()) {
+            for (size_t i = first; i < last; ++i) {
+                *this->batch[i].bytes_read = 0;
+            }
+        }
+
+        first = last;
+    }
+
+    // Resumed tasks queue their next reads into pending, which becomes the next tick.
+    const size_t count = this->batch.size();
+    for (const PendingRead& read : this->batch) {
+        this->resume(read.handle);
+    }
+    this->batch.clear();
+
+    if (this->exception) {
+        std::rethrow_exception(std::exchange(this->exception, nullptr));
+    }
+
+    return count;
+}
+
+size_t ReadExecutor::run(size_t max_ticks) {
+    size_t ticks = 0;
+    while (!this->pending.empty() && ticks < max_ticks) {
+        this->tick();
+        ++ticks;
+    }
+    return ticks;
+}
+
+void ReadExecutor::resume(std::coroutine_handle<ReadTask::promise_type> handle) {
+    handle.resume();
+    if (!handle.done()) {
+        return;
+    }
+
+    const size_t index = handle.promise().index;
+    this->tasks[index] = this->tasks.back();
+    this->tasks[index].promise().index = index;
+    this->tasks.pop_back();
+    handle.destroy();
+}
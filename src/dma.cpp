@@ -3,13 +3,14 @@
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <sstream>
 
 #include "external/vmm/vmmdll.h"
 
 #include "include/VolkDMA/inputstate.hh"
+#include "include/VolkDMA/internal/stackstring.hh"
 #include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
 
 template<typename T>
 T DMA::read(uint64_t address, DWORD process_id) const {
@@ -35,7 +36,7 @@ DMA::DMA(bool use_memory_map) {
         path = (std::filesystem::current_path() / "memory_map.txt").string();
 
         if (!std::filesystem::exists(path) && !dump_memory_map()) {
-            std::cerr << "[DMA] Could not dump memory map.\n";
+            Log::warning("[DMA] Could not dump memory map.");
         }
         else {
             argv[argc++] = "-memmap";
@@ -45,37 +46,39 @@ DMA::DMA(bool use_memory_map) {
 
     handle.reset(VMMDLL_Initialize(argc, argv));
     if (!handle) {
-        std::cerr << "[DMA] Failed to initialize.\n";
+        Log::error("[DMA] Failed to initialize.");
         return;
     }
 
     this->clean_fpga();
 }
 
-DWORD DMA::get_process_id(const std::string& process_name) const {
+DWORD DMA::get_process_id(std::string_view process_name) const {
+    const StackString name(process_name);
     DWORD process_id = 0;
 
-    if (!VMMDLL_PidGetFromName(this->handle.get(), process_name.c_str(), &process_id) || process_id == 0) {
-        std::cerr << "[PROCESS] Failed to get ID for process: " << process_name << ".\n";
+    if (!name || !VMMDLL_PidGetFromName(this->handle.get(), name.c_str(), &process_id) || process_id == 0) {
+        Log::error("[PROCESS] Failed to get ID for process: {}.", process_name);
     }
 
     return process_id;
 }
 
-std::vector<DWORD> DMA::get_process_id_list(const std::string& process_name) const {
+std::vector<DWORD> DMA::get_process_id_list(std::string_view process_name) const {
+    const StackString name(process_name);
     std::vector<DWORD> list = { };
 
     VolkResource<VMMDLL_PROCESS_INFORMATION> process_info{};
     DWORD total_processes = 0;
 
     if (!VMMDLL_ProcessGetInformationAll(this->handle.get(), process_info.out(), &total_processes) || total_processes == 0) {
-        std::cerr << "[PROCESS] Failed to retrieve process process list.\n";
+        Log::error("[PROCESS] Failed to retrieve process process list.");
         return list;
     }
 
     for (size_t i = 0; i < total_processes; i++) {
         const auto& process = process_info.get()[i];
-        if (strstr(process.szNameLong, process_name.c_str())) {
+        if (name && strstr(process.szNameLong, name.c_str())) {
             list.push_back(process.dwPID);
         }
     }
@@ -134,20 +137,20 @@ bool DMA::dump_memory_map() {
 
     VolkHandle temp_handle(VMMDLL_Initialize(argc, argv), vmm_close);
     if (!temp_handle) {
-        std::cerr << "[DMA] Failed to open handle.\n";
+        Log::error("[DMA] Failed to open handle.");
         return false;
     }
 
     VolkResource<VMMDLL_MAP_PHYSMEM> p_phys_mem_map{};
     if (!VMMDLL_Map_GetPhysMem(temp_handle.get(), p_phys_mem_map.out())) {
-        std::cerr << "[DMA] Failed to get physical memory map.\n";
+        Log::error("[DMA] Failed to get physical memory map.");
         return false;
     }
 
     if (!p_phys_mem_map ||
         p_phys_mem_map->dwVersion != VMMDLL_MAP_PHYSMEM_VERSION ||
         p_phys_mem_map->cMap == 0) {
-        std::cerr << "[DMA] Invalid memory map.\n";
+        Log::error("[DMA] Invalid memory map.");
         return false;
     }
 
@@ -172,7 +175,7 @@ bool DMA::clean_fpga() {
     ULONG64 fpga_id = 0, version_major = 0, version_minor = 0;
 
     if (!(VMMDLL_ConfigGet(this->handle.get(), LC_OPT_FPGA_FPGA_ID, &fpga_id) && VMMDLL_ConfigGet(this->handle.get(), LC_OPT_FPGA_VERSION_MAJOR, &version_major) && VMMDLL_ConfigGet(this->handle.get(), LC_OPT_FPGA_VERSION_MINOR, &version_minor))) {
-        std::cerr << "[DMA] Failed to lookup FPGA device. Attempting to continue initializing.\n";
+        Log::warning("[DMA] Failed to lookup FPGA device. Attempting to continue initializing.");
         return false;
     }
 
@@ -181,7 +184,7 @@ bool DMA::clean_fpga() {
         HANDLE lc_handle = LcCreate(&config);
 
         if (!lc_handle) {
-            std::cerr << "[DMA] Failed to create FPGA device handle. Attempting to continue initializing.\n";
+            Log::warning("[DMA] Failed to create FPGA device handle. Attempting to continue initializing.");
             return false;
         }
 
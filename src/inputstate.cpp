@@ -6,40 +6,43 @@
 
 #include "include/VolkDMA/dma.hh"
 #include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/symbols.hh"
 
-InputState::InputState(const DMA& dma) : dma(dma) {
+InputState::InputState(const DMA& dma, const std::filesystem::path& symbol_cache_path) : dma(dma) {
     const std::vector<DWORD> csrss_process_ids = dma.get_process_id_list("csrss.exe");
 
     if (retrieve_gptCursorAsync(csrss_process_ids)) {
         std::cout << "[INPUTSTATE] Successfully retrieved gptCursorAsync!\n";
     }
     else {
-        std::cerr << "[INPUTSTATE] Failed to retrieve gptCursorAsync!\n";
+        Log::error("[INPUTSTATE] Failed to retrieve gptCursorAsync!");
     }
 
     if (!VMMDLL_ConfigGet(dma.handle.get(), VMMDLL_OPT_WIN_VERSION_BUILD, &windows_version_build)) {
-        std::cerr << "[INPUTSTATE] Failed to retrieve Windows build!\n";
+        Log::error("[INPUTSTATE] Failed to retrieve Windows build!");
         return;
     }
 
-    if (retrieve_gafAsyncKeyState(csrss_process_ids)) {
+    SymbolResolver symbols(dma, symbol_cache_path.empty() ? SymbolResolver::get_default_cache_path() : symbol_cache_path);
+    if (retrieve_gafAsyncKeyState(csrss_process_ids, symbols)) {
         std::cout << "[INPUTSTATE] Successfully retrieved gafAsyncKeyState!\n";
     }
     else {
-        std::cerr << "[INPUTSTATE] Failed to retrieve gafAsyncKeyState!\n";
+        Log::error("[INPUTSTATE] Failed to retrieve gafAsyncKeyState!");
     }
 }
 
-bool InputState::retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_process_ids) {
+bool InputState::retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_process_ids, SymbolResolver& symbols) {
     winlogon_process_id = dma.get_process_id("winlogon.exe");
     if (!winlogon_process_id) {
-        std::cerr << "[INPUTSTATE] Failed to get process ID for winlogon.exe.\n";
+        Log::error("[INPUTSTATE] Failed to get process ID for winlogon.exe.");
         return false;
     }
 
     if (windows_version_build > 22000) {
         if (csrss_process_ids.empty()) {
-            std::cerr << "[INPUTSTATE] No csrss.exe processes found.\n";
+            Log::error("[INPUTSTATE] No csrss.exe processes found.");
             return false;
         }
 
@@ -53,39 +56,57 @@ bool InputState::retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_proce
                 win32k_module_name = "win32k.sys";
             }
             else {
-                std::cerr << "[INPUTSTATE] Failed to find win32ksgd.sys or win32k.sys for csrss.exe with process ID: " << process_id << "\n";
+                Log::error("[INPUTSTATE] Failed to find win32ksgd.sys or win32k.sys for csrss.exe with process ID: {}", process_id);
                 continue;
             }
 
-            uint64_t g_session_address = dma.find_signature("48 8B 05 ? ? ? ? 48 8B 04 C8", win32k_module_info->vaBase, win32k_module_info->vaBase + win32k_module_info->cbImageSize, process_id);
-            if (!g_session_address)
-                g_session_address = dma.find_signature("48 8B 05 ? ? ? ? FF C9", win32k_module_info->vaBase, win32k_module_info->vaBase + win32k_module_info->cbImageSize, process_id);
+            uint64_t session_slots_address = symbols.get_symbol_address(process_id, std::string(win32k_module_name), "gSessionGlobalSlots");
+            if (!session_slots_address) {
+                uint64_t g_session_address = dma.find_signature("48 8B 05 ? ? ? ? 48 8B 04 C8", win32k_module_info->vaBase, win32k_module_info->vaBase + win32k_module_info->cbImageSize, process_id);
+                if (!g_session_address)
+                    g_session_address = dma.find_signature("48 8B 05 ? ? ? ? FF C9", win32k_module_info->vaBase, win32k_module_info->vaBase + win32k_module_info->cbImageSize, process_id);
 
-            if (!g_session_address) {
-                std::cerr << "[INPUTSTATE] Failed to find signature in " << win32k_module_name << " for csrss.exe with process ID: " << process_id << "\n";
-                continue;
+                if (!g_session_address) {
+                    Log::error("[INPUTSTATE] Failed to find signature in {} for csrss.exe with process ID: {}", win32k_module_name, process_id);
+                    continue;
+                }
+
+                session_slots_address = g_session_address + 7 + dma.read<int>(g_session_address + 3, process_id);
+                symbols.store_symbol_address(process_id, std::string(win32k_module_name), "gSessionGlobalSlots", session_slots_address);
             }
 
             uint64_t user_session_state = 0;
             for (int i = 0; i < 4; i++) {
-                user_session_state = dma.read<uint64_t>(dma.read<uint64_t>(dma.read<uint64_t>(g_session_address + 7 + dma.read<int>(g_session_address + 3, process_id), process_id) + 8 * i, process_id), process_id);
+                user_session_state = dma.read<uint64_t>(dma.read<uint64_t>(dma.read<uint64_t>(session_slots_address, process_id) + 8 * i, process_id), process_id);
                 if (user_session_state > 0x7FFFFFFFFFFF)
                     break;
             }
 
-            VolkResource<VMMDLL_MAP_MODULEENTRY> win32kbase_info{};
-            if (!VMMDLL_Map_GetModuleFromNameW(dma.handle.get(), process_id, const_cast<LPWSTR>(L"win32kbase.sys"), win32kbase_info.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
-                std::cerr << "[INPUTSTATE] Failed to find win32kbase.sys for csrss.exe with process ID: " << process_id << "\n";
-                continue;
+            // The offset of gafAsyncKeyState inside the user session state comes from the
+            // win32kbase PDB. The signature is only scanned for when no PDB is available.
+            uint64_t key_state_offset = 0;
+            uint32_t key_state_field_offset = 0;
+            if (symbols.get_type_offset(process_id, "win32kbase.sys", "tagUSERSESSIONSTATE", "gafAsyncKeyState", key_state_field_offset)) {
+                key_state_offset = key_state_field_offset;
             }
-
-            uint64_t sig_ptr = dma.find_signature("48 8D 90 ? ? ? ? E8 ? ? ? ? 0F 57 C0", win32kbase_info->vaBase, win32kbase_info->vaBase + win32kbase_info->cbImageSize, process_id);
-            if (!sig_ptr) {
-                std::cerr << "[INPUTSTATE] Failed to find signature in win32kbase.sys for csrss.exe with process ID: " << process_id << "\n";
-                continue;
+            else if (!symbols.get_cached_value(process_id, "win32kbase.sys", "gafAsyncKeyState_offset", key_state_offset)) {
+                VolkResource<VMMDLL_MAP_MODULEENTRY> win32kbase_info{};
+                if (!VMMDLL_Map_GetModuleFromNameW(dma.handle.get(), process_id, const_cast<LPWSTR>(L"win32kbase.sys"), win32kbase_info.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+                    Log::error("[INPUTSTATE] Failed to find win32kbase.sys for csrss.exe with process ID: {}", process_id);
+                    continue;
+                }
+
+                uint64_t sig_ptr = dma.find_signature("48 8D 90 ? ? ? ? E8 ? ? ? ? 0F 57 C0", win32kbase_info->vaBase, win32kbase_info->vaBase + win32kbase_info->cbImageSize, process_id);
+                if (!sig_ptr) {
+                    Log::error("[INPUTSTATE] Failed to find signature in win32kbase.sys for csrss.exe with process ID: {}", process_id);
+                    continue;
+                }
+
+                key_state_offset = dma.read<uint32_t>(sig_ptr + 3, process_id);
+                symbols.store_cached_value(process_id, "win32kbase.sys", "gafAsyncKeyState_offset", key_state_offset);
             }
 
-            gafAsyncKeyState_address = user_session_state + dma.read<uint32_t>(sig_ptr + 3, process_id);
+            gafAsyncKeyState_address = user_session_state + key_state_offset;
 
             if (gafAsyncKeyState_address > 0x7FFFFFFFFFFF) {
                 return true;
@@ -98,7 +119,7 @@ bool InputState::retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_proce
     // windows_version_build <= 22000
     VolkResource<VMMDLL_MAP_EAT> eat_map{};
     if (!VMMDLL_Map_GetEATU(dma.handle.get(), winlogon_process_id | VMMDLL_PID_PROCESS_WITH_KERNELMEMORY, const_cast<LPSTR>("win32kbase.sys"), eat_map.out()) || eat_map->dwVersion != VMMDLL_MAP_EAT_VERSION) {
-        std::cerr << "[INPUTSTATE] Failed to retrieve EAT map in win32kbase.sys for winlogon.exe with process ID: " << winlogon_process_id << "\n";
+        Log::error("[INPUTSTATE] Failed to retrieve EAT map in win32kbase.sys for winlogon.exe with process ID: {}", winlogon_process_id);
         return false;
     }
 
@@ -115,19 +136,19 @@ bool InputState::retrieve_gafAsyncKeyState(const std::vector<DWORD>& csrss_proce
 
 bool InputState::retrieve_gptCursorAsync(const std::vector<DWORD>& csrss_process_ids) {
     if (csrss_process_ids.empty()) {
-        std::cerr << "[INPUTSTATE] No csrss.exe processes found.\n";
+        Log::error("[INPUTSTATE] No csrss.exe processes found.");
         return false;
     }
 
     for (const DWORD& process_id : csrss_process_ids) {
         VolkResource<VMMDLL_MAP_EAT> eat_map;
         if (!VMMDLL_Map_GetEATU(dma.handle.get(), process_id | VMMDLL_PID_PROCESS_WITH_KERNELMEMORY, const_cast<LPSTR>("win32kbase.sys"), eat_map.out())) {
-            std::cerr << "[INPUTSTATE] Failed to retrieve EAT map in win32kbase.sys for csrss.exe with process ID: " << process_id << "\n";
+            Log::error("[INPUTSTATE] Failed to retrieve EAT map in win32kbase.sys for csrss.exe with process ID: {}", process_id);
             continue;
         }
 
         if (eat_map->dwVersion != VMMDLL_MAP_EAT_VERSION) {
-            std::cerr << "[INPUTSTATE] EAT version mismatch for process ID " << process_id << ": got " << eat_map->dwVersion << "\n";
+            Log::error("[INPUTSTATE] EAT version mismatch for process ID {}: got {}", process_id, eat_map->dwVersion);
             continue;
         }
 
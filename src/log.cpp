@@ -0,0 +1,324 @@
+#include "include/VolkDMA/log.hh"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr size_t ring_capacity = 1024;
+static constexpr size_t rate_slot_count = 256;
+
+struct LogCell {
+    std::atomic<size_t> sequence{ 0 };
+    LogRecord record;
+};
+
+struct LogRateSlot {
+    std::atomic<const char*> format{ nullptr };
+    std::atomic<int64_t> window{ 0 };
+    std::atomic<uint32_t> count{ 0 };
+    std::atomic<uint32_t> suppressed{ 0 };
+};
+
+class LogState {
+public:
+    std::atomic<LogLevel> level{ LogLevel::info };
+    std::atomic<uint32_t> rate_limit{ 20 };
+    std::atomic<uint64_t> dropped{ 0 };
+
+    std::array<LogRateSlot, rate_slot_count> rate_slots;
+
+    std::mutex sinks_mutex;
+    std::vector<LogSink> sinks;
+
+    LogState() : cells(std::make_unique<LogCell[]>(ring_capacity)) {
+        for (size_t i = 0; i < ring_capacity; ++i) {
+            this->cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        this->sinks.push_back(Log::stderr_sink());
+        this->consumer = std::thread([this] { this->run(); });
+    }
+
+    ~LogState() {
+        this->stopping = true;
+        this->wake();
+        this->consumer.join();
+    }
+
+    // Bounded MPSC queue: producers claim a slot with a CAS on enqueue_position and
+    // publish it through the slot sequence, the consumer owns dequeue_position.
+    bool push(const LogRecord& record) {
+        size_t position = this->enqueue_position.load(std::memory_order_relaxed);
+        LogCell* cell = nullptr;
+
+        for (;;) {
+            cell = &this->cells[position & (ring_capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0) {
+                if (this->enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = this->enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::memcpy(&cell->record, &record, offsetof(LogRecord, text) + record.text_size);
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        this->wake();
+        return true;
+    }
+
+    void flush() {
+        const size_t target = this->enqueue_position.load(std::memory_order_acquire);
+        this->wake();
+
+        for (size_t processed = this->processed.load(); processed < target; processed = this->processed.load()) {
+            this->processed.wait(processed);
+        }
+    }
+
+private:
+    std::unique_ptr<LogCell[]> cells;
+    std::atomic<size_t> enqueue_position{ 0 };
+    size_t dequeue_position = 0;
+
+    std::atomic<uint32_t> pending{ 0 };
+    std::atomic<bool> sleeping{ false };
+    std::atomic<size_t> processed{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::thread consumer;
+
+    void wake() {
+        this->pending.fetch_add(1);
+        if (this->sleeping.load()) {
+            this->pending.notify_one();
+        }
+    }
+
+    bool pop(LogRecord& record) {
+        LogCell& cell = this->cells[this->dequeue_position & (ring_capacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != this->dequeue_position + 1) {
+            return false;
+        }
+
+        record = cell.record;
+        cell.sequence.store(this->dequeue_position + ring_capacity, std::memory_order_release);
+        ++this->dequeue_position;
+        return true;
+    }
+
+    void run() {
+        LogRecord record;
+        std::string line;
+
+        for (;;) {
+            const uint32_t observed = this->pending.load();
+
+            bool drained = false;
+            {
+                std::lock_guard lock(this->sinks_mutex);
+                while (this->pop(record)) {
+                    format(record, line);
+                    for (const LogSink& sink : this->sinks) {
+                        sink(record.level, line);
+                    }
+                    drained = true;
+                }
+            }
+
+            if (drained) {
+                this->processed.store(this->dequeue_position);
+                this->processed.notify_all();
+                continue;
+            }
+
+            if (this->stopping) {
+                break;
+            }
+
+            this->sleeping.store(true);
+            if (this->pending.load() == observed) {
+                this->pending.wait(observed);
+            }
+            this->sleeping.store(false);
+        }
+
+        this->processed.store(static_cast<size_t>(-1));
+        this->processed.notify_all();
+    }
+
+    static void append_argument(const LogRecord& record, const LogArgument& argument, bool hex, std::string& line) {
+        char buffer[32];
+        int size = 0;
+
+        switch (argument.type) {
+        case LogArgument::Type::signed_integer:
+            size = hex ? std::snprintf(buffer, sizeof(buffer), "%llx", static_cast<unsigned long long>(argument.signed_value))
+                       : std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(argument.signed_value));
+            break;
+        case LogArgument::Type::unsigned_integer:
+            size = std::snprintf(buffer, sizeof(buffer), hex ? "%llx" : "%llu", static_cast<unsigned long long>(argument.unsigned_value));
+            break;
+        case LogArgument::Type::floating:
+            size = std::snprintf(buffer, sizeof(buffer), "%g", argument.floating_value);
+            break;
+        case LogArgument::Type::string:
+            line.append(record.text + argument.text.offset, argument.text.size);
+            return;
+        }
+
+        line.append(buffer, static_cast<size_t>(std::max(size, 0)));
+    }
+
+    static void format(const LogRecord& record, std::string& line) {
+        line.clear();
+        size_t next_argument = 0;
+
+        for (const char* c = record.format; *c; ++c) {
+            if (c[0] == '{' && c[1] == '{') {
+                line.push_back('{');
+                ++c;
+                continue;
+            }
+            if (c[0] == '}' && c[1] == '}') {
+                line.push_back('}');
+                ++c;
+                continue;
+            }
+            if (c[0] != '{') {
+                line.push_back(*c);
+                continue;
+            }
+
+            const char* end = std::strchr(c, '}');
+            if (!end) {
+                line.append(c);
+                break;
+            }
+
+            const std::string_view spec(c + 1, static_cast<size_t>(end - c - 1));
+            if (next_argument < record.argument_count) {
+                append_argument(record, record.arguments[next_argument++], spec == ":x", line);
+            }
+            c = end;
+        }
+
+        if (record.suppressed != 0) {
+            line += " (";
+            line += std::to_string(record.suppressed);
+            line += " similar messages suppressed)";
+        }
+    }
+};
+
+static LogState& state() {
+    static LogState instance;
+    return instance;
+}
+
+bool Log::admit(LogLevel level, const char* format, uint32_t& suppressed) {
+    LogState& log = state();
+    if (level < log.level.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const uint32_t limit = log.rate_limit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+
+    LogRateSlot& slot = log.rate_slots[(reinterpret_cast<uintptr_t>(format) >> 3) % rate_slot_count];
+    const char* owner = slot.format.load(std::memory_order_relaxed);
+    if (owner != format) {
+        // Colliding call sites share a slot; the newest one takes it over and does not
+        // inherit the previous owner's suppressed count.
+        slot.format.store(format, std::memory_order_relaxed);
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.suppressed.store(0, std::memory_order_relaxed);
+    }
+
+    const int64_t window = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t current = slot.window.load(std::memory_order_relaxed);
+    if (current != window && slot.window.compare_exchange_strong(current, window, std::memory_order_relaxed)) {
+        slot.count.store(0, std::memory_order_relaxed);
+    }
+
+    if (slot.count.fetch_add(1, std::memory_order_relaxed) >= limit) {
+        slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void Log::submit(const LogRecord& record) {
+    LogState& log = state();
+    if (!log.push(record)) {
+        log.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Log::set_level(LogLevel level) {
+    state().level.store(level, std::memory_order_relaxed);
+}
+
+void Log::set_rate_limit(uint32_t messages_per_second) {
+    state().rate_limit.store(messages_per_second, std::memory_order_relaxed);
+}
+
+void Log::add_sink(LogSink sink) {
+    LogState& log = state();
+    std::lock_guard lock(log.sinks_mutex);
+    log.sinks.push_back(std::move(sink));
+}
+
+void Log::clear_sinks() {
+    LogState& log = state();
+    std::lock_guard lock(log.sinks_mutex);
+    log.sinks.clear();
+}
+
+void Log::flush() {
+    state().flush();
+}
+
+uint64_t Log::get_dropped_count() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+LogSink Log::stderr_sink() {
+    return [](LogLevel, std::string_view message) {
+        std::cerr << message << '\n';
+    };
+}
+
+LogSink Log::file_sink(const std::string& path) {
+    auto file = std::make_shared<std::ofstream>(path, std::ios::app);
+    if (!*file) {
+        std::cerr << "[LOG] Failed to open log file: " << path << ".\n";
+    }
+
+    return [file](LogLevel, std::string_view message) {
+        if (*file) {
+            *file << message << '\n';
+            file->flush();
+        }
+    };
+}
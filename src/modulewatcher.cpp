@@ -0,0 +1,186 @@
+#include "include/VolkDMA/modulewatcher.hh"
+
+#include <algorithm>
+#include <cctype>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+size_t ModuleWatcher::NameHash::operator()(std::string_view text) const {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const unsigned char c : text) {
+        hash = (hash ^ static_cast<uint64_t>(std::tolower(c))) * 0x100000001b3ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool ModuleWatcher::NameEqual::operator()(std::string_view a, std::string_view b) const {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) { return std::tolower(x) == std::tolower(y); });
+}
+
+ModuleWatcher::ModuleWatcher(const Process& process, Callback callback) : process(process), callback(std::move(callback)) {}
+
+bool ModuleWatcher::poll() {
+    VolkResource<VMMDLL_MAP_MODULE> module_map{};
+    if (!VMMDLL_Map_GetModuleU(this->process.get_dma().handle.get(), this->process.get_process_id(), module_map.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        Log::error("[MODULES] Failed to get module list.");
+        return false;
+    }
+
+    this->current_spans.clear();
+    for (DWORD i = 0; i < module_map->cMap; ++i) {
+        const auto& entry = module_map->pMap[i];
+        this->current_spans.push_back({ entry.vaBase, static_cast<uint32_t>(entry.cbImageSize), static_cast<uint32_t>(i) });
+    }
+    std::sort(this->current_spans.begin(), this->current_spans.end(), [](const Span& a, const Span& b) { return a.base < b.base; });
+
+    auto same = [](const Span& a, const Span& b) { return a.base == b.base && a.size == b.size; };
+    if (std::equal(this->spans.begin(), this->spans.end(), this->current_spans.begin(), this->current_spans.end(), same)) {
+        this->spans.swap(this->current_spans);
+        return true;
+    }
+
+    std::vector<ModuleEvent> events;
+    size_t previous = 0;
+    size_t current = 0;
+
+    auto unload = [&](uint64_t base) {
+        auto it = this->modules.find(base);
+        if (it != this->modules.end()) {
+            events.push_back({ ModuleEventType::unloaded, it->second.entry });
+            this->erase(base);
+        }
+    };
+
+    auto load = [&](const Span& span) {
+        const auto& entry = module_map->pMap[span.index];
+
+        ModuleEntry module{};
+        module.base = entry.vaBase;
+        module.size = entry.cbImageSize;
+        module.name = entry.uszText ? entry.uszText : "";
+        module.path = entry.uszFullName ? entry.uszFullName : "";
+
+        events.push_back({ ModuleEventType::loaded, module });
+        this->insert(std::move(module));
+    };
+
+    while (previous < this->spans.size() || current < this->current_spans.size()) {
+        if (current == this->current_spans.size() || (previous < this->spans.size() && this->spans[previous].base < this->current_spans[current].base)) {
+            unload(this->spans[previous++].base);
+            continue;
+        }
+
+        if (previous == this->spans.size() || this->current_spans[current].base < this->spans[previous].base) {
+            load(this->current_spans[current++]);
+            continue;
+        }
+
+        // Same base: a different size means the image was replaced between polls.
+        if (!same(this->spans[previous], this->current_spans[current])) {
+            unload(this->spans[previous].base);
+            load(this->current_spans[current]);
+        }
+        ++previous;
+        ++current;
+    }
+
+    this->spans.swap(this->current_spans);
+
+    if (this->callback) {
+        for (const ModuleEvent& event : events) {
+            this->callback(event);
+        }
+    }
+
+    return true;
+}
+
+const ModuleEntry* ModuleWatcher::find(std::string_view module_name) const {
+    auto name = this->name_index.find(module_name);
+    if (name == this->name_index.end()) {
+        return nullptr;
+    }
+
+    auto it = this->modules.find(name->second);
+    return it != this->modules.end() ? &it->second.entry : nullptr;
+}
+
+uint64_t ModuleWatcher::get_proc_address(std::string_view module_name, std::string_view function_name) {
+    Module* module = this->find_module(module_name);
+    if (!module) {
+        Log::error("[MODULES] Module not loaded: {}.", module_name);
+        return 0;
+    }
+
+    if (!module->exports && !this->build_exports(*module)) {
+        return 0;
+    }
+
+    auto it = module->exports->find(function_name);
+    return it != module->exports->end() ? it->second : 0;
+}
+
+ModuleWatcher::Module* ModuleWatcher::find_module(std::string_view module_name) {
+    auto name = this->name_index.find(module_name);
+    if (name == this->name_index.end()) {
+        return nullptr;
+    }
+
+    auto it = this->modules.find(name->second);
+    return it != this->modules.end() ? &it->second : nullptr;
+}
+
+bool ModuleWatcher::build_exports(Module& module) const {
+    VolkResource<VMMDLL_MAP_EAT> eat_map{};
+    if (!VMMDLL_Map_GetEATU(this->process.get_dma().handle.get(), this->process.get_process_id(), module.entry.name.c_str(), eat_map.out()) || eat_map->dwVersion != VMMDLL_MAP_EAT_VERSION) {
+        Log::error("[MODULES] Failed to retrieve export table for module: {}.", module.entry.name);
+        return false;
+    }
+
+    auto exports = std::make_unique<StringMap>();
+    exports->reserve(eat_map->cMap);
+
+    for (DWORD i = 0; i < eat_map->cMap; ++i) {
+        const auto& entry = eat_map->pMap[i];
+        if (entry.uszFunction && entry.uszFunction[0] && entry.vaFunction) {
+            exports->emplace(entry.uszFunction, entry.vaFunction);
+        }
+    }
+
+    module.exports = std::move(exports);
+    return true;
+}
+
+void ModuleWatcher::insert(ModuleEntry entry) {
+    const uint64_t base = entry.base;
+    this->name_index.emplace(entry.name, base);
+    this->modules.insert_or_assign(base, Module{ std::move(entry), nullptr });
+}
+
+void ModuleWatcher::erase(uint64_t base) {
+    auto it = this->modules.find(base);
+    if (it == this->modules.end()) {
+        return;
+    }
+
+    const std::string name = std::move(it->second.entry.name);
+    this->modules.erase(it);
+
+    auto indexed = this->name_index.find(name);
+    if (indexed == this->name_index.end() || indexed->second != base) {
+        return;
+    }
+
+    this->name_index.erase(indexed);
+    for (const auto& [other_base, other] : this->modules) {
+        if (NameEqual{}(other.entry.name, name)) {
+            this->name_index.emplace(other.entry.name, other_base);
+            break;
+        }
+    }
+}
@@ -0,0 +1,360 @@
+#include "include/VolkDMA/pointerscan.hh"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <windows.h>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+static constexpr size_t page_size = 0x1000;
+static constexpr uint32_t no_module = std::numeric_limits<uint32_t>::max();
+
+std::vector<uint64_t> PointerPath::get_chain() const {
+    std::vector<uint64_t> chain;
+    chain.reserve(this->offsets.size() + 1);
+    chain.push_back(this->module_offset);
+    chain.insert(chain.end(), this->offsets.begin(), this->offsets.end());
+    return chain;
+}
+
+PointerScanner::PointerScanner(const Process& process, PointerScanOptions options) : process(process), options(options) {}
+
+bool PointerScanner::snapshot() {
+    this->records.clear();
+    this->static_ranges.clear();
+    this->mapped_ranges.clear();
+    this->module_names.clear();
+    this->module_bases.clear();
+
+    VolkResource<VMMDLL_MAP_VAD> vad_map{};
+    if (!VMMDLL_Map_GetVadU(this->process.get_dma().handle.get(), this->process.get_process_id(), FALSE, vad_map.out()) || vad_map->dwVersion != VMMDLL_MAP_VAD_VERSION) {
+        Log::error("[POINTERSCAN] Failed to retrieve VAD map (Process ID: {}).", this->process.get_process_id());
+        return false;
+    }
+
+    std::vector<Range> scan_ranges;
+    for (DWORD i = 0; i < vad_map->cMap; ++i) {
+        const auto& entry = vad_map->pMap[i];
+        this->mapped_ranges.push_back({ entry.vaStart, entry.vaEnd + 1, no_module });
+
+        if (this->options.include_heaps && entry.fPrivateMemory && !entry.fImage && entry.CommitCharge != 0) {
+            scan_ranges.push_back({ entry.vaStart, entry.vaEnd + 1, no_module });
+        }
+    }
+    std::sort(this->mapped_ranges.begin(), this->mapped_ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+    this->collect_module_ranges(scan_ranges);
+    if (this->static_ranges.empty()) {
+        Log::error("[POINTERSCAN] No writable module sections found.");
+        return false;
+    }
+
+    const uint64_t chunk_size = std::max<uint64_t>(this->options.chunk_size & ~(page_size - 1), page_size);
+    std::vector<Range> chunks;
+    for (const Range& range : scan_ranges) {
+        for (uint64_t begin = range.begin; begin < range.end; begin += chunk_size) {
+            chunks.push_back({ begin, std::min(begin + chunk_size, range.end), range.module_index });
+        }
+    }
+
+    const size_t worker_count = std::clamp<size_t>(this->options.threads, 1, std::max<size_t>(chunks.size(), 1));
+    std::vector<std::vector<PointerRecord>> found(worker_count);
+    std::atomic<size_t> next{ 0 };
+
+    auto worker = [&](size_t index) {
+        for (size_t i = next++; i < chunks.size(); i = next++) {
+            this->collect_pointers(chunks[i], found[index]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    size_t total = 0;
+    for (const auto& part : found) {
+        total += part.size();
+    }
+
+    this->records.reserve(total);
+    for (auto& part : found) {
+        this->records.insert(this->records.end(), part.begin(), part.end());
+        part = {};
+    }
+
+    std::sort(this->records.begin(), this->records.end(), [](const PointerRecord& a, const PointerRecord& b) {
+        return a.value != b.value ? a.value < b.value : a.location < b.location;
+    });
+
+    return !this->records.empty();
+}
+
+std::vector<PointerPath> PointerScanner::find_paths(uint64_t target) const {
+    struct Task {
+        uint64_t address;
+        std::vector<uint64_t> offsets;
+        std::vector<uint64_t> addresses;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    const size_t worker_count = std::max<size_t>(this->options.threads, 1);
+    std::vector<Worker> workers(worker_count);
+    std::atomic<size_t> pending{ 1 };
+    std::atomic<size_t> queued{ 1 };
+    std::atomic<size_t> idle{ 0 };
+    std::atomic<bool> stop{ false };
+    std::mutex idle_mutex;
+    std::condition_variable idle_condition;
+    std::mutex results_mutex;
+    std::vector<PointerPath> results;
+
+    // Sleepers register in idle before checking for work, so a producer that sees idle == 0
+    // knows any later sleeper will see its task.
+    auto wake = [&](bool all) {
+        if (idle == 0) {
+            return;
+        }
+        { std::lock_guard lock(idle_mutex); }
+        if (all) {
+            idle_condition.notify_all();
+        }
+        else {
+            idle_condition.notify_one();
+        }
+    };
+
+    workers[0].tasks.push_back({ target, {}, { target } });
+
+    // Owners pop from the back of their own deque; idle workers steal from the front of others.
+    auto take = [&](size_t self, Task& task) {
+        for (size_t k = 0; k < worker_count; ++k) {
+            Worker& victim = workers[(self + k) % worker_count];
+            std::lock_guard lock(victim.mutex);
+            if (victim.tasks.empty()) {
+                continue;
+            }
+
+            if (k == 0) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+            }
+            else {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+            --queued;
+            return true;
+        }
+        return false;
+    };
+
+    auto run = [&](size_t self) {
+        Task task;
+        while (!stop) {
+            if (!take(self, task)) {
+                std::unique_lock lock(idle_mutex);
+                ++idle;
+                idle_condition.wait(lock, [&] { return stop || pending == 0 || queued != 0; });
+                --idle;
+                if (stop || pending == 0) {
+                    break;
+                }
+                continue;
+            }
+
+            const uint64_t lowest = task.address > this->options.max_offset ? task.address - this->options.max_offset : 0;
+            auto it = std::lower_bound(this->records.begin(), this->records.end(), lowest, [](const PointerRecord& record, uint64_t value) { return record.value < value; });
+
+            for (; it != this->records.end() && it->value <= task.address && !stop; ++it) {
+                const uint64_t offset = task.address - it->value;
+
+                if (const Range* range = this->find_range(this->static_ranges, it->location)) {
+                    PointerPath path{};
+                    path.module_name = this->module_names[range->module_index];
+                    path.module_offset = it->location - this->module_bases[range->module_index];
+                    path.offsets.reserve(task.offsets.size() + 1);
+                    path.offsets.push_back(offset);
+                    path.offsets.insert(path.offsets.end(), task.offsets.rbegin(), task.offsets.rend());
+
+                    std::lock_guard lock(results_mutex);
+                    if (results.size() >= this->options.max_results) {
+                        stop = true;
+                        break;
+                    }
+                    results.push_back(std::move(path));
+                    continue;
+                }
+
+                // A location reached again through a different suffix still leads to different
+                // paths, so only a location already on this task's own chain is cut as a cycle.
+                if (task.offsets.size() + 1 >= this->options.max_depth || std::find(task.addresses.begin(), task.addresses.end(), it->location) != task.addresses.end()) {
+                    continue;
+                }
+
+                Task child{ it->location, task.offsets, task.addresses };
+                child.offsets.push_back(offset);
+                child.addresses.push_back(it->location);
+
+                ++pending;
+                ++queued;
+                {
+                    std::lock_guard lock(workers[self].mutex);
+                    workers[self].tasks.push_back(std::move(child));
+                }
+                wake(false);
+            }
+
+            if (--pending == 0 || stop) {
+                wake(true);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < worker_count; ++i) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::sort(results.begin(), results.end(), [](const PointerPath& a, const PointerPath& b) {
+        if (a.offsets.size() != b.offsets.size()) {
+            return a.offsets.size() < b.offsets.size();
+        }
+        if (a.module_name != b.module_name) {
+            return a.module_name < b.module_name;
+        }
+        if (a.module_offset != b.module_offset) {
+            return a.module_offset < b.module_offset;
+        }
+        return a.offsets < b.offsets;
+    });
+
+    return results;
+}
+
+const PointerScanner::Range* PointerScanner::find_range(const std::vector<Range>& ranges, uint64_t address) const {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), address, [](uint64_t value, const Range& range) { return value < range.begin; });
+    if (it == ranges.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    return address < it->end ? &*it : nullptr;
+}
+
+void PointerScanner::collect_module_ranges(std::vector<Range>& scan_ranges) {
+    VolkResource<VMMDLL_MAP_MODULE> module_map{};
+    if (!VMMDLL_Map_GetModuleU(this->process.get_dma().handle.get(), this->process.get_process_id(), module_map.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        Log::error("[POINTERSCAN] Failed to get module list.");
+        return;
+    }
+
+    std::vector<std::array<uint8_t, page_size>> headers(module_map->cMap);
+
+    ScatterContext scatter = this->process.acquire_scatter();
+    if (!scatter) {
+        return;
+    }
+
+    for (DWORD i = 0; i < module_map->cMap; ++i) {
+        scatter.add_read(module_map->pMap[i].vaBase, headers[i].data(), page_size);
+    }
+
+    if (!scatter.execute()) {
+        return;
+    }
+
+    for (DWORD i = 0; i < module_map->cMap; ++i) {
+        const auto& entry = module_map->pMap[i];
+        const uint8_t* image = headers[i].data();
+
+        IMAGE_DOS_HEADER dos{};
+        std::memcpy(&dos, image, sizeof(dos));
+        if (dos.e_magic != IMAGE_DOS_SIGNATURE || dos.e_lfanew <= 0 || dos.e_lfanew + sizeof(IMAGE_NT_HEADERS64) > page_size) {
+            continue;
+        }
+
+        IMAGE_NT_HEADERS64 nt{};
+        std::memcpy(&nt, image + dos.e_lfanew, sizeof(nt));
+        if (nt.Signature != IMAGE_NT_SIGNATURE) {
+            continue;
+        }
+
+        const uint32_t module_index = static_cast<uint32_t>(this->module_names.size());
+        this->module_names.emplace_back(entry.uszText ? entry.uszText : "");
+        this->module_bases.push_back(entry.vaBase);
+
+        const size_t section_offset = dos.e_lfanew + FIELD_OFFSET(IMAGE_NT_HEADERS64, OptionalHeader) + nt.FileHeader.SizeOfOptionalHeader;
+        for (size_t s = 0; s < nt.FileHeader.NumberOfSections; ++s) {
+            if (section_offset + (s + 1) * sizeof(IMAGE_SECTION_HEADER) > page_size) {
+                break;
+            }
+
+            IMAGE_SECTION_HEADER section{};
+            std::memcpy(&section, image + section_offset + s * sizeof(IMAGE_SECTION_HEADER), sizeof(section));
+            if (!(section.Characteristics & IMAGE_SCN_MEM_WRITE) || section.Misc.VirtualSize == 0) {
+                continue;
+            }
+
+            const uint64_t begin = entry.vaBase + section.VirtualAddress;
+            const uint64_t end = begin + ((section.Misc.VirtualSize + page_size - 1) & ~(page_size - 1));
+            this->static_ranges.push_back({ begin, end, module_index });
+            scan_ranges.push_back({ begin, end, module_index });
+        }
+    }
+
+    std::sort(this->static_ranges.begin(), this->static_ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+}
+
+void PointerScanner::collect_pointers(const Range& range, std::vector<PointerRecord>& out) const {
+    RangeRead data;
+    if (this->mapped_ranges.empty() || this->process.read_range(range.begin, static_cast<size_t>(range.end - range.begin), data) == VolkStatus::read_failed) {
+        return;
+    }
+
+    const uint64_t lowest = this->mapped_ranges.front().begin;
+    const uint64_t highest = this->mapped_ranges.back().end;
+
+    for (size_t page = 0; page < data.page_count; ++page) {
+        if (!data.is_page_valid(page)) {
+            continue;
+        }
+
+        const uint8_t* page_data = data.data.data() + page * page_size;
+        const size_t page_bytes = std::min<size_t>(page_size, data.data.size() - page * page_size);
+        for (size_t offset = 0; offset + sizeof(uint64_t) <= page_bytes; offset += sizeof(uint64_t)) {
+            uint64_t value = 0;
+            std::memcpy(&value, page_data + offset, sizeof(value));
+
+            if (value < lowest || value >= highest || !this->find_range(this->mapped_ranges, value)) {
+                continue;
+            }
+
+            out.push_back({ value, range.begin + page * page_size + offset });
+        }
+    }
+}
@@ -1,85 +1,122 @@
 #include "include/VolkDMA/process.hh"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
-#include <iostream>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <windows.h>
 
 #include "external/vmm/vmmdll.h"
 
 #include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/internal/stackstring.hh"
 #include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
 
 static constexpr DWORD scatter_flags = VMMDLL_FLAG_NOCACHE | VMMDLL_FLAG_ZEROPAD_ON_FAIL | VMMDLL_FLAG_SCATTER_PREPAREEX_NOMEMZERO;
 
-static uint64_t cb_size = 0x80000;
+static constexpr size_t scatter_pool_limit = 16;
+
 VOID cb_add_file(_Inout_ HANDLE h, _In_ LPCSTR uszName, _In_ ULONG64 cb, _In_opt_ PVMMDLL_VFS_FILELIST_EXINFO pExInfo) {
     if (strcmp(uszName, "dtb.txt") == 0)
-        cb_size = cb;
+        *static_cast<uint64_t*>(h) = cb;
 }
 
 Process::Process(DMA& dma, const std::string& process_name) : dma(dma), process_id(dma.get_process_id(process_name)) {}
 
-uint64_t Process::get_base_address(const std::string& module_name) const {
-    VolkResource<VMMDLL_MAP_MODULEENTRY> module_entry{};
+Process::~Process() {
+    for (VMMDLL_SCATTER_HANDLE scatter_handle : this->scatter_pool) {
+        VMMDLL_Scatter_CloseHandle(scatter_handle);
+    }
+}
 
-    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, module_name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
-        std::cerr << "[PROCESS] Failed to find base address of module: " << module_name << ".\n";
+uint64_t Process::get_base_address(std::string_view module_name) const {
+    VolkResult<uint64_t> base_address = this->try_get_base_address(module_name);
+    if (!base_address) {
+        Log::error("[PROCESS] Failed to find base address of module: {}.", module_name);
         return 0;
     }
 
-    return static_cast<uint64_t>(module_entry->vaBase);
+    return base_address.value;
+}
+
+VolkResult<uint64_t> Process::try_get_base_address(std::string_view module_name) const {
+    const StackString name(module_name);
+    if (!name) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return { 0, VolkStatus::invalid_argument };
+    }
+
+    VolkResource<VMMDLL_MAP_MODULEENTRY> module_entry{};
+    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return { 0, VolkStatus::not_found };
+    }
+
+    return { static_cast<uint64_t>(module_entry->vaBase), VolkStatus::ok };
 }
 
-size_t Process::get_size(const std::string& module_name) const {
+size_t Process::get_size(std::string_view module_name) const {
+    const StackString name(module_name);
     VolkResource<VMMDLL_MAP_MODULEENTRY> module_entry{};
 
-    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, module_name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
-        std::cerr << "[PROCESS] Failed to find size of module: " << module_name << ".\n";
+    if (!name || !VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        Log::error("[PROCESS] Failed to find size of module: {}.", module_name);
         return 0;
     }
 
     return static_cast<size_t>(module_entry->cbImageSize);
 }
 
-bool Process::dump_module(const std::string& module_name, const std::string& path) const {
+bool Process::dump_module(std::string_view module_name, const std::string& path) const {
     const uint64_t base_address = this->get_base_address(module_name);
     if (!base_address) {
-        std::cerr << "[PROCESS] Failed to get base address for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Failed to get base address for module: {}.", module_name);
         return false;
     }
 
     IMAGE_DOS_HEADER dos{};
     if (!read(base_address, &dos, sizeof(IMAGE_DOS_HEADER))) {
-        std::cerr << "[PROCESS] Failed to read IMAGE_DOS_HEADER for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Failed to read IMAGE_DOS_HEADER for module: {}.", module_name);
         return false;
     }
 
     if (dos.e_magic != IMAGE_DOS_SIGNATURE) {
-        std::cerr << "[PROCESS] Invalid DOS signature for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Invalid DOS signature for module: {}.", module_name);
         return false;
     }
 
     IMAGE_NT_HEADERS64 nt{};
     if (!this->read(base_address + dos.e_lfanew, &nt, sizeof(nt))) {
-        std::cerr << "[PROCESS] Failed to read IMAGE_NT_HEADERS64 for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Failed to read IMAGE_NT_HEADERS64 for module: {}.", module_name);
         return false;
     }
 
     if (nt.Signature != IMAGE_NT_SIGNATURE || nt.OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
-        std::cerr << "[PROCESS] Invalid NT headers for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Invalid NT headers for module: {}.", module_name);
         return false;
     }
 
     const size_t image_size = nt.OptionalHeader.SizeOfImage;
-    auto image_buffer = std::make_unique<uint8_t[]>(image_size);
+    RangeRead image;
+
+    if (this->read_range(base_address, image_size, image, 1) == VolkStatus::read_failed) {
+        Log::error("[PROCESS] Failed to read image of module: {}.", module_name);
+        return false;
+    }
+
+    if (!image.is_complete()) {
+        Log::warning("[PROCESS] {} of {} pages unreadable for module: {}, dumping them as zeros.", image.page_count - image.valid_count, image.page_count, module_name);
+    }
 
-    this->read(base_address, image_buffer.get(), image_size);
-    auto section_header = reinterpret_cast<PIMAGE_SECTION_HEADER>(image_buffer.get() + dos.e_lfanew + FIELD_OFFSET(IMAGE_NT_HEADERS64, OptionalHeader) + nt.FileHeader.SizeOfOptionalHeader);
+    uint8_t* image_buffer = image.data.data();
+    auto section_header = reinterpret_cast<PIMAGE_SECTION_HEADER>(image_buffer + dos.e_lfanew + FIELD_OFFSET(IMAGE_NT_HEADERS64, OptionalHeader) + nt.FileHeader.SizeOfOptionalHeader);
 
     for (size_t i = 0; i < nt.FileHeader.NumberOfSections; i++, section_header++) {
         section_header->PointerToRawData = section_header->VirtualAddress;
@@ -92,22 +129,23 @@ bool Process::dump_module(const std::string& module_name, const std::string& pat
     }
 
     DWORD written = 0;
-    BOOL success = WriteFile(file_handle, image_buffer.get(), static_cast<DWORD>(image_size), &written, nullptr);
+    BOOL success = WriteFile(file_handle, image_buffer, static_cast<DWORD>(image_size), &written, nullptr);
     CloseHandle(file_handle);
 
     if (!success || written != image_size) {
-        std::cerr << "[PROCESS] Failed to write dump for module: " << module_name << ".\n";
+        Log::error("[PROCESS] Failed to write dump for module: {}.", module_name);
         return false;
     }
 
     return true;
 }
 
-std::string Process::get_path(const std::string& module_name) const {
+std::string Process::get_path(std::string_view module_name) const {
+    const StackString name(module_name);
     VolkResource<VMMDLL_MAP_MODULEENTRY> mod;
 
-    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, module_name.c_str(), mod.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
-        std::cerr << "[PROCESS] Failed to find path for module: " << module_name << ".\n";
+    if (!name || !VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, name.c_str(), mod.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        Log::error("[PROCESS] Failed to find path for module: {}.", module_name);
         return {};
     }
 
@@ -121,7 +159,7 @@ std::vector<std::string> Process::get_modules(DWORD process_id) const {
     VolkResource<VMMDLL_MAP_MODULE> module_map;
 
     if (!VMMDLL_Map_GetModuleU(this->dma.handle.get(), target_process_id, module_map.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
-        std::cerr << "[PROCESS] Failed to get module list.\n";
+        Log::error("[PROCESS] Failed to get module list.");
         return modules;
     }
 
@@ -140,12 +178,12 @@ bool Process::fix_cr3(const std::string& process_name) {
     VolkResource<VMMDLL_MAP_MODULEENTRY> module_entry;
     
     if (VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, process_name.c_str(), module_entry.out(), NULL)) {
-        std::cerr << "[PROCESS] CR3 fix not needed.\n";
+        Log::info("[PROCESS] CR3 fix not needed.");
         return true;
     }
 
     if (!VMMDLL_InitializePlugins(this->dma.handle.get())) {
-        std::cerr << "[PROCESS] Failed to initialize plugins.\n";
+        Log::error("[PROCESS] Failed to initialize plugins.");
         return false;
     }
 
@@ -160,9 +198,10 @@ bool Process::fix_cr3(const std::string& process_name) {
         Sleep(100);
     }
 
+    uint64_t cb_size = 0x80000;
     VMMDLL_VFS_FILELIST2 VfsFileList;
     VfsFileList.dwVersion = VMMDLL_VFS_FILELIST_VERSION;
-    VfsFileList.h = 0;
+    VfsFileList.h = &cb_size;
     VfsFileList.pfnAddDirectory = nullptr;
     VfsFileList.pfnAddFile = cb_add_file;
 
@@ -199,24 +238,24 @@ bool Process::fix_cr3(const std::string& process_name) {
     for (const auto& dtb : possible_dtbs) {
         VMMDLL_ConfigSet(this->dma.handle.get(), VMMDLL_OPT_PROCESS_DTB | this->process_id, dtb);
         if (VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), this->process_id, process_name.c_str(), module_entry.out(), NULL)) {
-            static ULONG64 pml4_first[512];
-            static ULONG64 pml4_second[512];
+            ULONG64 pml4_first[512];
+            ULONG64 pml4_second[512];
             DWORD read_size;
 
             if (!VMMDLL_MemReadEx(this->dma.handle.get(), -1, dtb, reinterpret_cast<PBYTE>(pml4_first), sizeof(pml4_first), &read_size,
                 VMMDLL_FLAG_NOCACHE | VMMDLL_FLAG_NOPAGING | VMMDLL_FLAG_ZEROPAD_ON_FAIL | VMMDLL_FLAG_NOPAGING_IO)) {
-                std::cerr << "[PROCESS] Failed to read PML4 the first time.\n";
+                Log::error("[PROCESS] Failed to read PML4 the first time.");
                 return false;
             }
 
             if (!VMMDLL_MemReadEx(this->dma.handle.get(), -1, dtb, reinterpret_cast<PBYTE>(pml4_second), sizeof(pml4_second), &read_size,
                 VMMDLL_FLAG_NOCACHE | VMMDLL_FLAG_NOPAGING | VMMDLL_FLAG_ZEROPAD_ON_FAIL | VMMDLL_FLAG_NOPAGING_IO)) {
-                std::cerr << "[PROCESS] Failed to read PML4 the second time.\n";
+                Log::error("[PROCESS] Failed to read PML4 the second time.");
                 return false;
             }
 
             if (memcmp(pml4_first, pml4_second, sizeof(pml4_first)) != 0) {
-                std::cerr << "[PROCESS] PML4 mismatch between reads.\n";
+                Log::error("[PROCESS] PML4 mismatch between reads.");
                 return false;
             }
 
@@ -227,7 +266,7 @@ bool Process::fix_cr3(const std::string& process_name) {
         }
     }
 
-    std::cerr << "[PROCESS] Failed to patch process: " << process_name << ".\n";
+    Log::error("[PROCESS] Failed to patch process: {}.", process_name);
     return false;
 }
 
@@ -240,48 +279,168 @@ bool Process::virtual_to_physical(uint64_t virtual_address, uint64_t& physical_a
 }
 
 bool Process::read(uint64_t address, void* buffer, size_t size) const {
-    if (!this->is_valid_address(address)) {
-        return false;
+    const VolkStatus status = this->try_read(address, buffer, size);
+    if (status == VolkStatus::read_failed) {
+        Log::error("[PROCESS] Failed to read memory at 0x{:x} (Process ID: {}).", address, this->process_id);
     }
 
+    return status == VolkStatus::ok;
+}
+
+VolkStatus Process::try_read(uint64_t address, void* buffer, size_t size) const {
+    VolkStatus status = VolkStatus::ok;
     DWORD read_size = 0;
-    if (!VMMDLL_MemReadEx(this->dma.handle.get(), this->process_id, address, static_cast<PBYTE>(buffer), size, &read_size, VMMDLL_FLAG_NOCACHE)) {
-        std::cerr << "[PROCESS] Failed to read memory at 0x" << std::hex << address << " (Process ID: " << std::dec << this->process_id << ").\n";
-        return false;
+
+    if (!this->is_valid_address(address)) {
+        status = VolkStatus::invalid_address;
+    }
+    else if (!VMMDLL_MemReadEx(this->dma.handle.get(), this->process_id, address, static_cast<PBYTE>(buffer), size, &read_size, VMMDLL_FLAG_NOCACHE)) {
+        status = VolkStatus::read_failed;
+    }
+    else if (read_size != size) {
+        status = VolkStatus::partial_read;
     }
 
-    return read_size == size;
+    if (status != VolkStatus::ok) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return status;
+}
+
+VolkStatus Process::read_range(uint64_t address, size_t size, RangeRead& range, uint32_t retries) const {
+    constexpr uint64_t page_size = RangeRead::page_size;
+
+    range.address = address;
+    range.data.resize(size);
+    range.page_count = 0;
+    range.valid_count = 0;
+    range.valid_pages.clear();
+
+    if (size == 0 || !this->is_valid_address(address)) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return VolkStatus::invalid_address;
+    }
+
+    const uint64_t first_page = address & ~(page_size - 1);
+    const uint64_t end = address + size;
+    range.page_count = static_cast<size_t>((end - first_page + page_size - 1) / page_size);
+    range.valid_pages.assign((range.page_count + 63) / 64, 0);
+
+    auto page_span = [&](size_t page, uint64_t& page_address, size_t& length) {
+        page_address = std::max(first_page + page * page_size, address);
+        length = static_cast<size_t>(std::min(first_page + (page + 1) * page_size, end) - page_address);
+    };
+
+    std::vector<DWORD> bytes_read(range.page_count);
+    uint64_t page_address = 0;
+    size_t length = 0;
+
+    // The first attempt reads every page; retries only re-read the pages that failed.
+    for (uint32_t attempt = 0; attempt <= retries && !range.is_complete(); ++attempt) {
+        ScatterContext scatter = this->acquire_scatter();
+        if (!scatter) {
+            break;
+        }
+
+        for (size_t page = 0; page < range.page_count; ++page) {
+            if (!range.is_page_valid(page)) {
+                page_span(page, page_address, length);
+                bytes_read[page] = 0;
+                scatter.add_read(page_address, range.data.data() + (page_address - address), length, &bytes_read[page]);
+            }
+        }
+
+        if (!scatter.execute()) {
+            continue;
+        }
+
+        for (size_t page = 0; page < range.page_count; ++page) {
+            page_span(page, page_address, length);
+            if (!range.is_page_valid(page) && bytes_read[page] == length) {
+                range.valid_pages[page / 64] |= uint64_t{ 1 } << (page % 64);
+                ++range.valid_count;
+            }
+        }
+    }
+
+    for (size_t page = 0; page < range.page_count; ++page) {
+        if (!range.is_page_valid(page)) {
+            page_span(page, page_address, length);
+            std::memset(range.data.data() + (page_address - address), 0, length);
+        }
+    }
+
+    if (range.is_complete()) {
+        return VolkStatus::ok;
+    }
+
+    this->failure_count.fetch_add(1, std::memory_order_relaxed);
+    return range.valid_count != 0 ? VolkStatus::partial_read : VolkStatus::read_failed;
 }
 
 uint64_t Process::read_chain(uint64_t base, const std::vector<uint64_t>& offsets) const {
-    uint64_t result = this->read<uint64_t>(base + offsets.at(0));
+    return this->read_chain(base, std::span<const uint64_t>(offsets));
+}
+
+uint64_t Process::read_chain(uint64_t base, std::span<const uint64_t> offsets) const {
+    if (offsets.empty()) {
+        return 0;
+    }
+
+    uint64_t result = this->read<uint64_t>(base + offsets[0]);
     for (size_t i = 1; i < offsets.size(); ++i) {
-        result = this->read<uint64_t>(result + offsets.at(i));
+        result = this->read<uint64_t>(result + offsets[i]);
+    }
+    return result;
+}
+
+VolkResult<uint64_t> Process::try_read_chain(uint64_t base, std::span<const uint64_t> offsets) const {
+    if (offsets.empty()) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return { 0, VolkStatus::invalid_argument };
+    }
+
+    VolkResult<uint64_t> result{ base, VolkStatus::ok };
+    for (const uint64_t offset : offsets) {
+        result = this->try_read<uint64_t>(result.value + offset);
+        if (!result) {
+            break;
+        }
     }
     return result;
 }
 
 bool Process::write(uint64_t address, void* buffer, size_t size, DWORD process_id) const {
+    const VolkStatus status = this->try_write(address, buffer, size, process_id);
+    if (status == VolkStatus::write_failed) {
+        Log::error("[PROCESS] Failed to write memory at 0x{:x} (Process ID: {}).", address, (process_id == 0) ? this->process_id : process_id);
+    }
+
+    return status == VolkStatus::ok;
+}
+
+VolkStatus Process::try_write(uint64_t address, const void* buffer, size_t size, DWORD process_id) const {
     if (!this->is_valid_address(address)) {
-        return false;
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return VolkStatus::invalid_address;
     }
 
     DWORD target_process_id = (process_id == 0) ? this->process_id : process_id;
 
-    if (!VMMDLL_MemWrite(this->dma.handle.get(), target_process_id, address, static_cast<PBYTE>(buffer), size)) {
-        std::cerr << "[PROCESS] Failed to write memory at 0x" << std::hex << address
-            << " (Process ID: " << std::dec << target_process_id << ").\n";
-        return false;
+    if (!VMMDLL_MemWrite(this->dma.handle.get(), target_process_id, address, static_cast<PBYTE>(const_cast<void*>(buffer)), size)) {
+        this->failure_count.fetch_add(1, std::memory_order_relaxed);
+        return VolkStatus::write_failed;
     }
 
-    return true;
+    return VolkStatus::ok;
 }
 
 VMMDLL_SCATTER_HANDLE Process::create_scatter(DWORD process_id) const {
     DWORD target_process_id = (process_id != 0) ? process_id : this->process_id;
     VMMDLL_SCATTER_HANDLE scatter_handle = VMMDLL_Scatter_Initialize(this->dma.handle.get(), target_process_id, scatter_flags);
     if (!scatter_handle) {
-        std::cerr << "[PROCESS] Failed to create scatter handle.\n";
+        Log::error("[PROCESS] Failed to create scatter handle.");
     }
     return scatter_handle;
 }
@@ -289,6 +448,7 @@ VMMDLL_SCATTER_HANDLE Process::create_scatter(DWORD process_id) const {
 void Process::close_scatter(VMMDLL_SCATTER_HANDLE scatter_handle) const {
     if (scatter_handle) {
         VMMDLL_Scatter_CloseHandle(scatter_handle);
+        std::lock_guard lock(this->scatter_counts_mutex);
         this->scatter_counts.erase(scatter_handle);
     }
 }
@@ -299,9 +459,11 @@ bool Process::add_read_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, uint64_t ad
     }
 
     if (!VMMDLL_Scatter_PrepareEx(scatter_handle, address, size, static_cast<PBYTE>(buffer), NULL)) {
-        std::cerr << "[PROCESS] Failed to prepare scatter read at 0x" << std::hex << address << std::dec << ".\n";
+        Log::error("[PROCESS] Failed to prepare scatter read at 0x{:x}.", address);
         return false;
     }
+
+    std::lock_guard lock(this->scatter_counts_mutex);
     ++this->scatter_counts[scatter_handle];
 
     return true;
@@ -313,34 +475,69 @@ bool Process::add_write_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, uint64_t a
     }
 
     if (!VMMDLL_Scatter_PrepareWrite(scatter_handle, address, static_cast<PBYTE>(buffer), size)) {
-        std::cerr << "[PROCESS] Failed to prepare scatter write at 0x" << std::hex << address << std::dec << ".\n";
+        Log::error("[PROCESS] Failed to prepare scatter write at 0x{:x}.", address);
         return false;
     }
+
+    std::lock_guard lock(this->scatter_counts_mutex);
     ++this->scatter_counts[scatter_handle];
 
     return true;
 }
 
 bool Process::execute_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id) const {
-    auto it = this->scatter_counts.find(scatter_handle);
-    if (it == this->scatter_counts.end() || it->second == 0) {
-        return true;
+    {
+        std::lock_guard lock(this->scatter_counts_mutex);
+        auto it = this->scatter_counts.find(scatter_handle);
+        if (it == this->scatter_counts.end() || it->second == 0) {
+            return true;
+        }
+        it->second = 0;
     }
 
     DWORD target_process_id = (process_id != 0) ? process_id : this->process_id;
+    return this->flush_scatter(scatter_handle, target_process_id);
+}
+
+ScatterContext Process::acquire_scatter(DWORD process_id) const {
+    DWORD target_process_id = (process_id != 0) ? process_id : this->process_id;
+
+    if (target_process_id == this->process_id) {
+        std::lock_guard lock(this->scatter_pool_mutex);
+        if (!this->scatter_pool.empty()) {
+            VMMDLL_SCATTER_HANDLE scatter_handle = this->scatter_pool.back();
+            this->scatter_pool.pop_back();
+            return ScatterContext(this, scatter_handle, target_process_id);
+        }
+    }
+
+    return ScatterContext(this, this->create_scatter(target_process_id), target_process_id);
+}
+
+bool Process::flush_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id) const {
     bool success = true;
 
     if (!VMMDLL_Scatter_Execute(scatter_handle)) {
-        std::cerr << "[PROCESS] Failed to execute scatter.\n";
+        Log::error("[PROCESS] Failed to execute scatter.");
         success = false;
     }
 
-    if (!VMMDLL_Scatter_Clear(scatter_handle, target_process_id, scatter_flags)) {
-        std::cerr << "[PROCESS] Failed to clear scatter.\n";
+    if (!VMMDLL_Scatter_Clear(scatter_handle, process_id, scatter_flags)) {
+        Log::error("[PROCESS] Failed to clear scatter.");
         success = false;
     }
 
-    it->second = 0;
-
     return success;
+}
+
+void Process::release_scatter(VMMDLL_SCATTER_HANDLE scatter_handle, DWORD process_id, bool pending) const {
+    if (process_id == this->process_id && (!pending || VMMDLL_Scatter_Clear(scatter_handle, process_id, scatter_flags))) {
+        std::lock_guard lock(this->scatter_pool_mutex);
+        if (this->scatter_pool.size() < scatter_pool_limit) {
+            this->scatter_pool.push_back(scatter_handle);
+            return;
+        }
+    }
+
+    VMMDLL_Scatter_CloseHandle(scatter_handle);
 }
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "include/VolkDMA/processtable.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/log.hh"
+
+static constexpr DWORD system_process_id = 4;
+
+static std::string to_lower(std::string_view text) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+ProcessTable::ProcessTable(const DMA& dma) : dma(dma) {}
+
+bool ProcessTable::refresh(std::vector<ProcessEvent>* events) {
+    SIZE_T count = 0;
+    if (!VMMDLL_PidList(this->dma.handle.get(), nullptr, &count) || count == 0) {
+        Log::error("[PROCESSTABLE] Failed to retrieve process ID list.");
+        return false;
+    }
+
+    // Leave headroom for processes started between the two calls.
+    this->current_ids.resize(count + 16);
+    count = this->current_ids.size();
+    if (!VMMDLL_PidList(this->dma.handle.get(), this->current_ids.data(), &count)) {
+        Log::error("[PROCESSTABLE] Failed to retrieve process ID list.");
+        return false;
+    }
+
+    this->current_ids.resize(std::min<size_t>(count, this->current_ids.size()));
+    std::sort(this->current_ids.begin(), this->current_ids.end());
+
+    this->survivors.clear();
+    this->started.clear();
+    this->replaced.clear();
+
+    size_t previous = 0;
+    size_t current = 0;
+    ProcessEntry entry{};
+
+    while (previous < this->process_ids.size() || current < this->current_ids.size()) {
+        if (current == this->current_ids.size() || (previous < this->process_ids.size() && this->process_ids[previous] < this->current_ids[current])) {
+            this->erase(this->process_ids[previous++], events);
+            continue;
+        }
+
+        const DWORD process_id = this->current_ids[current++];
+        if (previous < this->process_ids.size() && this->process_ids[previous] == process_id) {
+            this->survivors.push_back(process_id);
+            ++previous;
+            continue;
+        }
+
+        if (this->query(process_id, entry)) {
+            this->started.push_back(std::move(entry));
+            entry = {};
+        }
+    }
+
+    // One batch reads the creation time of every surviving and new process.
+    this->create_time_addresses.clear();
+    for (const DWORD process_id : this->survivors) {
+        this->create_time_addresses.push_back(this->entries.at(process_id).eprocess);
+    }
+    for (const ProcessEntry& started_entry : this->started) {
+        this->create_time_addresses.push_back(started_entry.eprocess);
+    }
+    this->read_create_times();
+
+    for (size_t i = 0; i < this->survivors.size(); ++i) {
+        const DWORD process_id = this->survivors[i];
+        ProcessEntry& known = this->entries.at(process_id);
+        if (this->create_times[i] != 0 && this->create_times[i] == known.create_time) {
+            continue;
+        }
+
+        // The creation time changed or could not be read; only now is the PID queried again.
+        if (!this->query(process_id, entry)) {
+            this->erase(process_id, events);
+            continue;
+        }
+
+        if (entry.eprocess == known.eprocess) {
+            if (known.create_time == 0 || this->create_times[i] == 0 || this->create_times[i] == known.create_time) {
+                known.create_time = known.create_time ? known.create_time : this->create_times[i];
+                entry = {};
+                continue;
+            }
+            entry.create_time = this->create_times[i];
+            this->erase(process_id, events);
+            this->insert(std::move(entry), events);
+        }
+        else {
+            this->erase(process_id, events);
+            this->replaced.push_back(std::move(entry));
+        }
+        entry = {};
+    }
+
+    for (size_t i = 0; i < this->started.size(); ++i) {
+        this->started[i].create_time = this->create_times[this->survivors.size() + i];
+        this->insert(std::move(this->started[i]), events);
+    }
+
+    // A reused PID with a new EPROCESS needs that EPROCESS's creation time, which the batch
+    // above read from the old address. This second batch only runs when a PID was reused.
+    if (!this->replaced.empty()) {
+        this->create_time_addresses.clear();
+        for (const ProcessEntry& replaced_entry : this->replaced) {
+            this->create_time_addresses.push_back(replaced_entry.eprocess);
+        }
+        this->read_create_times();
+
+        for (size_t i = 0; i < this->replaced.size(); ++i) {
+            this->replaced[i].create_time = this->create_times[i];
+            this->insert(std::move(this->replaced[i]), events);
+        }
+    }
+
+    this->process_ids.clear();
+    for (const DWORD process_id : this->current_ids) {
+        if (this->entries.contains(process_id)) {
+            this->process_ids.push_back(process_id);
+        }
+    }
+
+    return true;
+}
+
+DWORD ProcessTable::get_process_id(std::string_view process_name) const {
+    auto it = this->name_index.find(to_lower(process_name));
+    return it != this->name_index.end() ? it->second : 0;
+}
+
+std::vector<DWORD> ProcessTable::get_process_id_list(std::string_view process_name) const {
+    std::vector<DWORD> list;
+    auto [first, last] = this->name_index.equal_range(to_lower(process_name));
+    for (auto it = first; it != last; ++it) {
+        list.push_back(it->second);
+    }
+    std::sort(list.begin(), list.end());
+    return list;
+}
+
+const ProcessEntry* ProcessTable::find(DWORD process_id) const {
+    auto it = this->entries.find(process_id);
+    return it != this->entries.end() ? &it->second : nullptr;
+}
+
+bool ProcessTable::is_alive(DWORD process_id, uint64_t eprocess) const {
+    const ProcessEntry* entry = this->find(process_id);
+    return entry && (eprocess == 0 || entry->eprocess == eprocess);
+}
+
+bool ProcessTable::query(DWORD process_id, ProcessEntry& entry) const {
+    VMMDLL_PROCESS_INFORMATION info{};
+    info.magic = VMMDLL_PROCESS_INFORMATION_MAGIC;
+    info.wVersion = VMMDLL_PROCESS_INFORMATION_VERSION;
+    SIZE_T info_size = sizeof(info);
+
+    if (!VMMDLL_ProcessGetInformation(this->dma.handle.get(), process_id, &info, &info_size) || info.dwState != 0) {
+        return false;
+    }
+
+    entry.process_id = info.dwPID;
+    entry.parent_process_id = info.dwPPID;
+    entry.eprocess = info.win.vaEPROCESS;
+    entry.name.assign(info.szNameLong, strnlen(info.szNameLong, sizeof(info.szNameLong)));
+
+    return true;
+}
+
+// Reads EPROCESS.CreateTime for every address in create_time_addresses through the System
+// process. Entries that cannot be read, or every entry when the kernel PDB does not
+// provide the field offset, are left at zero.
+void ProcessTable::read_create_times() {
+    this->create_times.assign(this->create_time_addresses.size(), 0);
+    if (this->create_time_addresses.empty()) {
+        return;
+    }
+
+    if (!this->create_time_resolved) {
+        this->create_time_resolved = true;
+
+        DWORD offset = 0;
+        if (VMMDLL_PdbTypeChildOffset(this->dma.handle.get(), "nt", "_EPROCESS", "CreateTime", &offset)) {
+            this->create_time_offset = offset;
+        }
+        else {
+            Log::warning("[PROCESSTABLE] Failed to resolve _EPROCESS.CreateTime, surviving processes are queried on every refresh.");
+        }
+    }
+
+    if (this->create_time_offset == 0) {
+        return;
+    }
+
+    VMMDLL_SCATTER_HANDLE scatter_handle = VMMDLL_Scatter_Initialize(this->dma.handle.get(), system_process_id, VMMDLL_FLAG_NOCACHE);
+    if (!scatter_handle) {
+        Log::error("[PROCESSTABLE] Failed to create scatter handle.");
+        return;
+    }
+
+    std::vector<DWORD> bytes_read(this->create_time_addresses.size(), 0);
+    for (size_t i = 0; i < this->create_time_addresses.size(); ++i) {
+        const uint64_t address = this->create_time_addresses[i] + this->create_time_offset;
+        if (!VMMDLL_Scatter_PrepareEx(scatter_handle, address, sizeof(uint64_t), reinterpret_cast<PBYTE>(&this->create_times[i]), &bytes_read[i])) {
+            Log::error("[PROCESSTABLE] Failed to prepare scatter read at 0x{:x}.", address);
+        }
+    }
+
+    if (!VMMDLL_Scatter_Execute(scatter_handle)) {
+        std::fill(bytes_read.begin(), bytes_read.end(), 0);
+    }
+    VMMDLL_Scatter_CloseHandle(scatter_handle);
+
+    for (size_t i = 0; i < this->create_times.size(); ++i) {
+        if (bytes_read[i] != sizeof(uint64_t)) {
+            this->create_times[i] = 0;
+        }
+    }
+}
+
+void ProcessTable::insert(ProcessEntry entry, std::vector<ProcessEvent>* events) {
+    this->name_index.emplace(to_lower(entry.name), entry.process_id);
+
+    if (events) {
+        events->push_back({ ProcessEventType::started, entry });
+    }
+
+    const DWORD process_id = entry.process_id;
+    this->entries.insert_or_assign(process_id, std::move(entry));
+}
+
+void ProcessTable::erase(DWORD process_id, std::vector<ProcessEvent>* events) {
+    auto it = this->entries.find(process_id);
+    if (it == this->entries.end()) {
+        return;
+    }
+
+    auto [first, last] = this->name_index.equal_range(to_lower(it->second.name));
+    for (auto name = first; name != last; ++name) {
+        if (name->second == process_id) {
+            this->name_index.erase(name);
+            break;
+        }
+    }
+
+    if (events) {
+        events->push_back({ ProcessEventType::exited, std::move(it->second) });
+    }
+
+    this->entries.erase(it);
+}
+
+ProcessWatcher::ProcessWatcher(const DMA& dma, Callback callback, std::string process_name) : table(dma), callback(std::move(callback)), process_name(to_lower(process_name)) {}
+
+bool ProcessWatcher::poll() {
+    this->events.clear();
+    if (!this->table.refresh(&this->events)) {
+        return false;
+    }
+
+    for (const ProcessEvent& event : this->events) {
+        if (this->process_name.empty() || to_lower(event.process.name) == this->process_name) {
+            this->callback(event);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,384 @@
+#include "include/VolkDMA/scanner.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <emmintrin.h>
+#include <thread>
+#include <type_traits>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+static constexpr size_t page_size = 0x1000;
+static constexpr size_t max_chunk_size = 0x80000000;
+
+template <typename T>
+static bool matches(ScanCompare compare, T current, T previous, T value, T upper) {
+    switch (compare) {
+    case ScanCompare::exact:
+        return current == value;
+    case ScanCompare::range:
+        return current >= value && current <= upper;
+    case ScanCompare::changed:
+        return std::memcmp(&current, &previous, sizeof(T)) != 0;
+    case ScanCompare::unchanged:
+        return std::memcmp(&current, &previous, sizeof(T)) == 0;
+    case ScanCompare::increased:
+        return current > previous;
+    case ScanCompare::decreased:
+        return current < previous;
+    }
+    return false;
+}
+
+template <typename T>
+static constexpr bool has_vector_compare(ScanCompare compare) {
+    if (compare == ScanCompare::exact) {
+        return sizeof(T) == 4 || sizeof(T) == 8;
+    }
+
+    if (compare == ScanCompare::range) {
+        return std::is_floating_point_v<T> || sizeof(T) == 4;
+    }
+
+    return false;
+}
+
+// Returns one bit per matching lane of a 16-byte block.
+template <typename T>
+static int vector_compare(__m128i block, ScanCompare compare, T value, T upper) {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m128 lanes = _mm_castsi128_ps(block);
+        if (compare == ScanCompare::exact) {
+            return _mm_movemask_ps(_mm_cmpeq_ps(lanes, _mm_set1_ps(value)));
+        }
+        return _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(lanes, _mm_set1_ps(value)), _mm_cmple_ps(lanes, _mm_set1_ps(upper))));
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+        const __m128d lanes = _mm_castsi128_pd(block);
+        if (compare == ScanCompare::exact) {
+            return _mm_movemask_pd(_mm_cmpeq_pd(lanes, _mm_set1_pd(value)));
+        }
+        return _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(lanes, _mm_set1_pd(value)), _mm_cmple_pd(lanes, _mm_set1_pd(upper))));
+    }
+    else if constexpr (sizeof(T) == 4) {
+        if (compare == ScanCompare::exact) {
+            return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int32_t>(value)))));
+        }
+
+        // Unsigned ranges are compared as signed after flipping the sign bit.
+        const __m128i bias = _mm_set1_epi32(std::is_signed_v<T> ? 0 : static_cast<int32_t>(0x80000000));
+        const __m128i lanes = _mm_xor_si128(block, bias);
+        const __m128i lower = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(value)), bias);
+        const __m128i higher = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(upper)), bias);
+        const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(lanes, lower), _mm_cmpgt_epi32(lanes, higher));
+        return ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+    }
+    else {
+        const __m128i halves = _mm_cmpeq_epi32(block, _mm_set1_epi64x(static_cast<int64_t>(value)));
+        const __m128i both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_movemask_pd(_mm_castsi128_pd(both));
+    }
+}
+
+template <typename T>
+static void scan_block(const uint8_t* data, size_t size, size_t alignment, uint32_t base_offset, ScanCompare compare, T value, T upper, std::vector<uint32_t>& offsets, std::vector<T>& values) {
+    size_t i = 0;
+
+    if (alignment == sizeof(T) && has_vector_compare<T>(compare)) {
+        for (; i + 16 <= size; i += 16) {
+            int mask = vector_compare<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), compare, value, upper);
+            while (mask) {
+                const size_t lane = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+                mask &= mask - 1;
+
+                T current;
+                std::memcpy(&current, data + i + lane * sizeof(T), sizeof(T));
+                offsets.push_back(base_offset + static_cast<uint32_t>(i + lane * sizeof(T)));
+                values.push_back(current);
+            }
+        }
+    }
+
+    for (; i + sizeof(T) <= size; i += alignment) {
+        T current;
+        std::memcpy(&current, data + i, sizeof(T));
+        if (matches(compare, current, current, value, upper)) {
+            offsets.push_back(base_offset + static_cast<uint32_t>(i));
+            values.push_back(current);
+        }
+    }
+}
+
+template <typename T>
+ValueScanner<T>::ValueScanner(const Process& process, ScanOptions options) : process(process), options(options), alignment(options.alignment ? options.alignment : sizeof(T)) {}
+
+template <typename T>
+size_t ValueScanner<T>::first_scan(ScanCompare compare, T value, T upper) {
+    if (compare != ScanCompare::exact && compare != ScanCompare::range) {
+        Log::error("[SCANNER] First scan only supports exact and range comparisons.");
+        return 0;
+    }
+
+    // Bitmap slots are offset / alignment, which only lines up with page-relative offsets
+    // when the alignment is a power of two no larger than a page.
+    if (!std::has_single_bit(this->alignment) || this->alignment > page_size) {
+        Log::error("[SCANNER] Alignment {} is not a power of two up to the page size.", this->alignment);
+        return 0;
+    }
+
+    this->chunks = this->enumerate_chunks();
+    this->run_parallel(this->chunks.size(), &ValueScanner::scan_chunk, compare, value, upper);
+    std::erase_if(this->chunks, [](const Chunk& chunk) { return chunk.count == 0; });
+
+    return this->size();
+}
+
+template <typename T>
+size_t ValueScanner<T>::next_scan(ScanCompare compare, T value, T upper) {
+    this->run_parallel(this->chunks.size(), &ValueScanner::rescan_chunk, compare, value, upper);
+    std::erase_if(this->chunks, [](const Chunk& chunk) { return chunk.count == 0; });
+
+    return this->size();
+}
+
+template <typename T>
+void ValueScanner<T>::reset() {
+    this->chunks.clear();
+}
+
+template <typename T>
+size_t ValueScanner<T>::size() const {
+    size_t total = 0;
+    for (const Chunk& chunk : this->chunks) {
+        total += chunk.count;
+    }
+    return total;
+}
+
+template <typename T>
+std::vector<uint64_t> ValueScanner<T>::get_addresses(size_t limit) const {
+    std::vector<uint64_t> addresses;
+    addresses.reserve(std::min(limit, this->size()));
+
+    for (const Chunk& chunk : this->chunks) {
+        if (!chunk.bitmap.empty()) {
+            for (size_t word = 0; word < chunk.bitmap.size(); ++word) {
+                for (uint64_t bits = chunk.bitmap[word]; bits; bits &= bits - 1) {
+                    if (addresses.size() >= limit) {
+                        return addresses;
+                    }
+                    addresses.push_back(chunk.base + (word * 64 + std::countr_zero(bits)) * this->alignment);
+                }
+            }
+        }
+        else {
+            for (const uint32_t offset : chunk.offsets) {
+                if (addresses.size() >= limit) {
+                    return addresses;
+                }
+                addresses.push_back(chunk.base + offset);
+            }
+        }
+    }
+
+    return addresses;
+}
+
+template <typename T>
+std::vector<typename ValueScanner<T>::Chunk> ValueScanner<T>::enumerate_chunks() const {
+    std::vector<Chunk> result;
+
+    VolkResource<VMMDLL_MAP_VAD> vad_map{};
+    if (!VMMDLL_Map_GetVadU(this->process.get_dma().handle.get(), this->process.get_process_id(), FALSE, vad_map.out()) || vad_map->dwVersion != VMMDLL_MAP_VAD_VERSION) {
+        Log::error("[SCANNER] Failed to retrieve VAD map (Process ID: {}).", this->process.get_process_id());
+        return result;
+    }
+
+    const size_t chunk_size = std::clamp<size_t>(this->options.chunk_size & ~(page_size - 1), page_size, max_chunk_size);
+
+    for (DWORD i = 0; i < vad_map->cMap; ++i) {
+        const auto& entry = vad_map->pMap[i];
+
+        if (entry.fImage && !this->options.include_images) {
+            continue;
+        }
+
+        if (!entry.fImage && !entry.fFile && entry.CommitCharge == 0) {
+            continue;
+        }
+
+        const uint64_t end = entry.vaEnd + 1;
+        for (uint64_t base = entry.vaStart; base < end; base += chunk_size) {
+            Chunk chunk{};
+            chunk.base = base;
+            chunk.size = std::min<uint64_t>(chunk_size, end - base);
+            result.push_back(std::move(chunk));
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+void ValueScanner<T>::run_parallel(size_t count, void (ValueScanner::*work)(Chunk&, ScanCompare, T, T) const, ScanCompare compare, T value, T upper) {
+    const size_t worker_count = std::clamp<size_t>(this->options.threads, 1, std::max<size_t>(count, 1));
+    std::atomic<size_t> next{ 0 };
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            (this->*work)(this->chunks[i], compare, value, upper);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
+
+template <typename T>
+void ValueScanner<T>::scan_chunk(Chunk& chunk, ScanCompare compare, T value, T upper) const {
+    RangeRead range;
+    if (this->process.read_range(chunk.base, static_cast<size_t>(chunk.size), range) == VolkStatus::read_failed) {
+        return;
+    }
+
+    std::vector<uint32_t> offsets;
+    for (size_t page = 0; page < range.page_count;) {
+        if (!range.is_page_valid(page)) {
+            ++page;
+            continue;
+        }
+
+        size_t run_end = page + 1;
+        while (run_end < range.page_count && range.is_page_valid(run_end)) {
+            ++run_end;
+        }
+
+        const size_t run_offset = page * page_size;
+        const size_t run_size = std::min<size_t>(run_end * page_size, range.data.size()) - run_offset;
+        scan_block(range.data.data() + run_offset, run_size, this->alignment, static_cast<uint32_t>(run_offset), compare, value, upper, offsets, chunk.values);
+        page = run_end;
+    }
+
+    this->compact(chunk, offsets);
+}
+
+template <typename T>
+void ValueScanner<T>::rescan_chunk(Chunk& chunk, ScanCompare compare, T value, T upper) const {
+    std::vector<uint32_t> candidates;
+    candidates.reserve(chunk.count);
+
+    if (!chunk.bitmap.empty()) {
+        for (size_t word = 0; word < chunk.bitmap.size(); ++word) {
+            for (uint64_t bits = chunk.bitmap[word]; bits; bits &= bits - 1) {
+                candidates.push_back(static_cast<uint32_t>((word * 64 + std::countr_zero(bits)) * this->alignment));
+            }
+        }
+    }
+    else {
+        candidates = chunk.offsets;
+    }
+
+    const size_t page_count = static_cast<size_t>((chunk.size + page_size - 1) / page_size);
+    std::vector<int32_t> page_slot(page_count, -1);
+    std::vector<size_t> pages;
+
+    for (const uint32_t offset : candidates) {
+        for (size_t page = offset / page_size; page <= (offset + sizeof(T) - 1) / page_size && page < page_count; ++page) {
+            if (page_slot[page] < 0) {
+                page_slot[page] = static_cast<int32_t>(pages.size());
+                pages.push_back(page);
+            }
+        }
+    }
+
+    std::vector<uint8_t> buffer(pages.size() * page_size);
+    std::vector<DWORD> page_read(pages.size());
+
+    // Candidates that cannot be re-read are dropped rather than carried over, since their
+    // previous values say nothing about this comparison.
+    ScatterContext scatter = this->process.acquire_scatter();
+    bool success = static_cast<bool>(scatter);
+
+    for (size_t slot = 0; success && slot < pages.size(); ++slot) {
+        scatter.add_read(chunk.base + pages[slot] * page_size, buffer.data() + slot * page_size, page_size, &page_read[slot]);
+    }
+
+    if (!success || !scatter.execute()) {
+        Log::warning("[SCANNER] Dropped {} candidates at 0x{:x} after a failed read.", candidates.size(), chunk.base);
+        candidates.clear();
+        chunk.values.clear();
+        this->compact(chunk, candidates);
+        return;
+    }
+
+    std::vector<uint32_t> offsets;
+    std::vector<T> values;
+
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        const uint32_t offset = candidates[k];
+        const size_t first_page = offset / page_size;
+        const size_t last_page = (offset + sizeof(T) - 1) / page_size;
+
+        if (last_page >= page_count || page_read[page_slot[first_page]] != page_size || page_read[page_slot[last_page]] != page_size) {
+            continue;
+        }
+
+        T current;
+        std::memcpy(&current, buffer.data() + page_slot[first_page] * page_size + (offset % page_size), sizeof(T));
+
+        if (matches(compare, current, chunk.values[k], value, upper)) {
+            offsets.push_back(offset);
+            values.push_back(current);
+        }
+    }
+
+    chunk.values = std::move(values);
+    this->compact(chunk, offsets);
+}
+
+// Dense chunks keep one bit per aligned slot; sparse chunks keep sorted offsets.
+template <typename T>
+void ValueScanner<T>::compact(Chunk& chunk, std::vector<uint32_t>& offsets) const {
+    const size_t slots = static_cast<size_t>(chunk.size / this->alignment);
+    chunk.count = offsets.size();
+
+    if (offsets.size() * 32 > slots) {
+        chunk.bitmap.assign((slots + 63) / 64, 0);
+        for (const uint32_t offset : offsets) {
+            const size_t slot = offset / this->alignment;
+            chunk.bitmap[slot / 64] |= uint64_t{ 1 } << (slot % 64);
+        }
+        chunk.offsets.clear();
+        chunk.offsets.shrink_to_fit();
+    }
+    else {
+        chunk.offsets = std::move(offsets);
+        chunk.bitmap.clear();
+        chunk.bitmap.shrink_to_fit();
+    }
+
+    chunk.values.shrink_to_fit();
+}
+
+template class ValueScanner<int32_t>;
+template class ValueScanner<uint32_t>;
+template class ValueScanner<int64_t>;
+template class ValueScanner<uint64_t>;
+template class ValueScanner<float>;
+template class ValueScanner<double>;
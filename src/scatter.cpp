@@ -0,0 +1,357 @@
+#include "include/VolkDMA/scatter.hh"
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+static size_t bucket_index(size_t entries) {
+    const size_t shift = static_cast<size_t>(std::bit_width(std::max<size_t>(entries, 1))) - 1;
+    return std::clamp<size_t>(shift, ScatterTuner::min_entries_shift, ScatterTuner::min_entries_shift + ScatterTuner::bucket_count - 1) - ScatterTuner::min_entries_shift;
+}
+
+static size_t concurrency_index(size_t concurrency) {
+    const auto& levels = ScatterTuner::concurrency_levels;
+    return static_cast<size_t>(std::find(levels.begin(), levels.end(), concurrency) - levels.begin()) % levels.size();
+}
+
+static void update_estimate(std::atomic<double>& cost, std::atomic<uint64_t>& samples, double value) {
+    const bool first = samples.fetch_add(1, std::memory_order_relaxed) == 0;
+    double current = cost.load(std::memory_order_relaxed);
+    while (!cost.compare_exchange_weak(current, first ? value : current + (value - current) * 0.25, std::memory_order_relaxed)) {
+    }
+}
+
+// Runs the background sub-batches of tuned contexts. The threads start on first use and are
+// shared by every Process; a context never has more than the highest concurrency level
+// minus one batch in flight, so that many threads keep one context fully overlapped.
+class ScatterWorkers {
+public:
+    ScatterWorkers() {
+        for (size_t i = 1; i < ScatterTuner::concurrency_levels.back(); ++i) {
+            this->threads.emplace_back([this] { this->run(); });
+        }
+    }
+
+    ~ScatterWorkers() {
+        {
+            std::lock_guard lock(this->mutex);
+            this->stopping = true;
+        }
+        this->condition.notify_all();
+        for (std::thread& thread : this->threads) {
+            thread.join();
+        }
+    }
+
+    std::future<bool> submit(std::packaged_task<bool()> task) {
+        std::future<bool> result = task.get_future();
+        {
+            std::lock_guard lock(this->mutex);
+            this->tasks.push_back(std::move(task));
+        }
+        this->condition.notify_one();
+        return result;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::packaged_task<bool()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+
+    void run() {
+        for (;;) {
+            std::packaged_task<bool()> task;
+            {
+                std::unique_lock lock(this->mutex);
+                this->condition.wait(lock, [this] { return this->stopping || !this->tasks.empty(); });
+                if (this->tasks.empty()) {
+                    return;
+                }
+                task = std::move(this->tasks.front());
+                this->tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+static ScatterWorkers& scatter_workers() {
+    static ScatterWorkers workers;
+    return workers;
+}
+
+ScatterTuning ScatterTuner::get_tuning() const {
+    return unpack(this->fixed.load(std::memory_order_acquire) ? this->fixed_tuning.load(std::memory_order_relaxed) : this->best_tuning.load(std::memory_order_relaxed));
+}
+
+bool ScatterTuner::is_fixed() const {
+    return this->fixed.load(std::memory_order_acquire);
+}
+
+double ScatterTuner::get_entry_cost(size_t max_entries) const {
+    return this->batch_costs[bucket_index(max_entries)].cost.load(std::memory_order_relaxed);
+}
+
+void ScatterTuner::set_fixed(ScatterTuning tuning) {
+    this->fixed_tuning.store(pack(tuning), std::memory_order_relaxed);
+    this->fixed.store(true, std::memory_order_release);
+}
+
+void ScatterTuner::clear_fixed() {
+    this->fixed.store(false, std::memory_order_release);
+}
+
+ScatterTuning ScatterTuner::plan() {
+    if (this->fixed.load(std::memory_order_acquire)) {
+        return unpack(this->fixed_tuning.load(std::memory_order_relaxed));
+    }
+
+    ScatterTuning tuning = unpack(this->best_tuning.load(std::memory_order_relaxed));
+    const uint64_t plan_index = this->plans.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (plan_index % 16 != 0) {
+        return tuning;
+    }
+
+    // Every 16th batch probes a neighbouring batch size or the next concurrency level.
+    const uint64_t probe = plan_index / 16;
+    if (probe % 2 == 0) {
+        const size_t bucket = bucket_index(tuning.max_entries);
+        const size_t neighbour = (probe / 2) % 2 ? std::min(bucket + 1, bucket_count - 1) : (bucket == 0 ? 1 : bucket - 1);
+        tuning.max_entries = size_t{ 1 } << (neighbour + min_entries_shift);
+    }
+    else {
+        tuning.concurrency = concurrency_levels[(concurrency_index(tuning.concurrency) + 1 + (probe / 2) % 2) % concurrency_levels.size()];
+    }
+
+    return tuning;
+}
+
+void ScatterTuner::record_batch(size_t entries, std::chrono::nanoseconds latency) {
+    if (entries == 0) {
+        return;
+    }
+
+    Estimate& estimate = this->batch_costs[bucket_index(entries)];
+    update_estimate(estimate.cost, estimate.samples, static_cast<double>(latency.count()) / static_cast<double>(entries));
+    this->update_best();
+}
+
+void ScatterTuner::record_stall(size_t concurrency, size_t entries, std::chrono::nanoseconds stall) {
+    if (entries == 0) {
+        return;
+    }
+
+    Estimate& estimate = this->stall_costs[concurrency_index(concurrency)];
+    update_estimate(estimate.cost, estimate.samples, static_cast<double>(stall.count()) / static_cast<double>(entries));
+    this->update_best();
+}
+
+void ScatterTuner::update_best() {
+    ScatterTuning best = unpack(this->best_tuning.load(std::memory_order_relaxed));
+
+    double best_batch = 0.0;
+    bool has_batch = false;
+    for (size_t i = 0; i < bucket_count; ++i) {
+        const Estimate& estimate = this->batch_costs[i];
+        const double cost = estimate.cost.load(std::memory_order_relaxed);
+        if (estimate.samples.load(std::memory_order_relaxed) != 0 && (!has_batch || cost < best_batch)) {
+            best_batch = cost;
+            has_batch = true;
+            best.max_entries = size_t{ 1 } << (i + min_entries_shift);
+        }
+    }
+
+    double best_stall = 0.0;
+    bool has_stall = false;
+    for (size_t i = 0; i < concurrency_levels.size(); ++i) {
+        const Estimate& estimate = this->stall_costs[i];
+        const double cost = estimate.cost.load(std::memory_order_relaxed);
+        if (estimate.samples.load(std::memory_order_relaxed) != 0 && (!has_stall || cost < best_stall)) {
+            best_stall = cost;
+            has_stall = true;
+            best.concurrency = concurrency_levels[i];
+        }
+    }
+
+    this->best_tuning.store(pack(best), std::memory_order_relaxed);
+}
+
+ScatterContext::ScatterContext(const Process* process, VMMDLL_SCATTER_HANDLE handle, DWORD process_id) : process(process), handle(handle), process_id(process_id) {}
+
+ScatterContext::~ScatterContext() {
+    this->reset();
+}
+
+ScatterContext::ScatterContext(ScatterContext&& other) noexcept
+    : process(std::exchange(other.process, nullptr)), handle(std::exchange(other.handle, nullptr)), process_id(std::exchange(other.process_id, 0)),
+      entries(std::exchange(other.entries, 0)), total_entries(std::exchange(other.total_entries, 0)), success(std::exchange(other.success, true)),
+      tuned(std::exchange(other.tuned, false)), tuning(std::exchange(other.tuning, ScatterTuning{ 0, 1 })), stall(std::exchange(other.stall, std::chrono::nanoseconds{ 0 })), in_flight(std::move(other.in_flight)) {}
+
+ScatterContext& ScatterContext::operator=(ScatterContext&& other) noexcept {
+    if (this != &other) {
+        this->reset();
+        this->process = std::exchange(other.process, nullptr);
+        this->handle = std::exchange(other.handle, nullptr);
+        this->process_id = std::exchange(other.process_id, 0);
+        this->entries = std::exchange(other.entries, 0);
+        this->total_entries = std::exchange(other.total_entries, 0);
+        this->success = std::exchange(other.success, true);
+        this->tuned = std::exchange(other.tuned, false);
+        this->tuning = std::exchange(other.tuning, ScatterTuning{ 0, 1 });
+        this->stall = std::exchange(other.stall, std::chrono::nanoseconds{ 0 });
+        this->in_flight = std::move(other.in_flight);
+    }
+    return *this;
+}
+
+bool ScatterContext::add_read(uint64_t address, void* buffer, size_t size, DWORD* bytes_read) {
+    if (!this->prepare() || !this->process->is_valid_address(address)) {
+        return false;
+    }
+
+    if (!VMMDLL_Scatter_PrepareEx(this->handle, address, static_cast<DWORD>(size), static_cast<PBYTE>(buffer), bytes_read)) {
+        Log::error("[SCATTER] Failed to prepare scatter read at 0x{:x}.", address);
+        return false;
+    }
+    ++this->entries;
+    ++this->total_entries;
+
+    return true;
+}
+
+bool ScatterContext::add_write(uint64_t address, void* buffer, size_t size) {
+    if (!this->prepare() || !this->process->is_valid_address(address)) {
+        return false;
+    }
+
+    if (!VMMDLL_Scatter_PrepareWrite(this->handle, address, static_cast<PBYTE>(buffer), static_cast<DWORD>(size))) {
+        Log::error("[SCATTER] Failed to prepare scatter write at 0x{:x}.", address);
+        return false;
+    }
+    ++this->entries;
+    ++this->total_entries;
+
+    return true;
+}
+
+bool ScatterContext::execute() {
+    if (!this->handle) {
+        return false;
+    }
+
+    if (this->total_entries == 0) {
+        return true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (this->entries != 0) {
+        this->success &= run_batch(this->process, this->handle, this->process_id, this->entries, this->tuned && this->entries == this->tuning.max_entries);
+        this->entries = 0;
+    }
+    this->success &= this->join();
+    this->stall += std::chrono::steady_clock::now() - start;
+
+    if (this->tuned && this->tuning.max_entries != 0 && this->total_entries > this->tuning.max_entries) {
+        this->process->scatter_tuner.record_stall(this->tuning.concurrency, this->total_entries, this->stall);
+    }
+
+    this->total_entries = 0;
+    return std::exchange(this->success, true);
+}
+
+void ScatterContext::reset() {
+    this->join();
+
+    if (this->handle) {
+        this->process->release_scatter(this->handle, this->process_id, this->entries != 0);
+    }
+
+    this->process = nullptr;
+    this->handle = nullptr;
+    this->process_id = 0;
+    this->entries = 0;
+    this->total_entries = 0;
+    this->success = true;
+    this->tuned = false;
+    this->tuning = { 0, 1 };
+    this->stall = std::chrono::nanoseconds{ 0 };
+}
+
+void ScatterContext::enable_tuning() {
+    this->tuned = true;
+}
+
+void ScatterContext::pin_tuning(ScatterTuning pinned_tuning) {
+    this->tuned = false;
+    this->tuning = pinned_tuning;
+}
+
+bool ScatterContext::prepare() {
+    if (!this->handle) {
+        return false;
+    }
+
+    if (this->total_entries == 0) {
+        if (this->tuned) {
+            this->tuning = this->process->scatter_tuner.plan();
+        }
+        this->stall = std::chrono::nanoseconds{ 0 };
+    }
+    else if (this->tuning.max_entries != 0 && this->entries >= this->tuning.max_entries) {
+        this->dispatch();
+    }
+
+    return true;
+}
+
+void ScatterContext::dispatch() {
+    if (this->tuning.concurrency > 1 && this->in_flight.size() + 1 < this->tuning.concurrency) {
+        ScatterContext next = this->process->acquire_scatter(this->process_id);
+        if (next.handle) {
+            VMMDLL_SCATTER_HANDLE full = std::exchange(this->handle, std::exchange(next.handle, nullptr));
+            const size_t full_entries = std::exchange(this->entries, 0);
+            std::packaged_task<bool()> task([process = this->process, full, process_id = this->process_id, full_entries, sample = this->tuned] {
+                return run_batch(process, full, process_id, full_entries, sample);
+            });
+            this->in_flight.push_back({ full, scatter_workers().submit(std::move(task)) });
+            return;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    this->success &= run_batch(this->process, this->handle, this->process_id, this->entries, this->tuned);
+    this->entries = 0;
+    this->stall += std::chrono::steady_clock::now() - start;
+}
+
+// Only full-size sub-batches are sampled. A short batch is dominated by the fixed round trip,
+// so its cost per entry would make whichever bucket it lands in look expensive.
+bool ScatterContext::run_batch(const Process* process, VMMDLL_SCATTER_HANDLE batch_handle, DWORD process_id, size_t batch_entries, bool sample) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool result = process->flush_scatter(batch_handle, process_id);
+    if (sample) {
+        process->scatter_tuner.record_batch(batch_entries, std::chrono::steady_clock::now() - start);
+    }
+    return result;
+}
+
+bool ScatterContext::join() {
+    bool result = true;
+    for (InFlight& batch : this->in_flight) {
+        result &= batch.result.get();
+        this->process->release_scatter(batch.handle, this->process_id, false);
+    }
+    this->in_flight.clear();
+    return result;
+}
@@ -0,0 +1,153 @@
+#include "include/VolkDMA/scheduler.hh"
+
+#include <algorithm>
+
+#include "include/VolkDMA/process.hh"
+
+ReadScheduler::ReadScheduler(const Process& process, ReadBudget budget) : process(process), budget(budget) {}
+
+bool ReadScheduler::submit(const ScheduledRead& read) {
+    // A read larger than the byte budget could never be scheduled.
+    if (!read.buffer || read.size == 0 || read.size > this->budget.max_bytes || !this->process.is_valid_address(read.address)) {
+        return false;
+    }
+
+    if (read.state) {
+        *read.state = ReadState::pending;
+    }
+
+    this->queues[static_cast<size_t>(read.priority) % priority_count].push_back({ read, 0 });
+    return true;
+}
+
+ReadSchedulerStats ReadScheduler::run_frame() {
+    ReadSchedulerStats frame{};
+    const auto now = std::chrono::steady_clock::now();
+
+    for (std::vector<Pending>& queue : this->queues) {
+        auto expired = std::stable_partition(queue.begin(), queue.end(), [&](const Pending& pending) { return pending.read.deadline >= now; });
+        for (auto it = expired; it != queue.end(); ++it) {
+            this->finish(*it, ReadState::expired);
+            ++frame.expired;
+        }
+        queue.erase(expired, queue.end());
+
+        // set_budget() may have shrunk max_bytes below reads that were already queued.
+        auto oversized = std::stable_partition(queue.begin(), queue.end(), [&](const Pending& pending) { return pending.read.size <= this->budget.max_bytes; });
+        for (auto it = oversized; it != queue.end(); ++it) {
+            this->finish(*it, ReadState::dropped);
+            ++frame.dropped;
+        }
+        queue.erase(oversized, queue.end());
+
+        std::stable_sort(queue.begin(), queue.end(), [](const Pending& a, const Pending& b) { return a.read.deadline < b.read.deadline; });
+    }
+
+    size_t bytes_left = this->budget.max_bytes;
+
+    for (size_t round_trip = 0; round_trip < this->budget.max_round_trips; ++round_trip) {
+        this->batch.clear();
+
+        // Priorities are strict: once a request had to be left out, lower tiers wait too.
+        bool skipped = false;
+        for (std::vector<Pending>& queue : this->queues) {
+            if (skipped) {
+                break;
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < queue.size(); ++i) {
+                Pending& pending = queue[i];
+                if (this->batch.size() < this->budget.entries_per_round_trip && pending.read.size <= bytes_left) {
+                    bytes_left -= pending.read.size;
+                    this->batch.push_back(pending);
+                    continue;
+                }
+                skipped = true;
+                queue[kept++] = pending;
+            }
+            queue.resize(kept);
+        }
+
+        if (this->batch.empty()) {
+            break;
+        }
+
+        ScatterContext scatter = this->process.acquire_scatter();
+        this->bytes_read.assign(this->batch.size(), 0);
+
+        for (size_t i = 0; i < this->batch.size(); ++i) {
+            const ScheduledRead& read = this->batch[i].read;
+            scatter.add_read(read.address, read.buffer, read.size, &this->bytes_read[i]);
+        }
+
+        const bool executed = scatter.execute();
+        const auto completed_at = std::chrono::steady_clock::now();
+
+        ++frame.round_trips;
+        for (size_t i = 0; i < this->batch.size(); ++i) {
+            const Pending& pending = this->batch[i];
+            frame.bytes += pending.read.size;
+
+            if (!executed || this->bytes_read[i] != pending.read.size) {
+                this->finish(pending, ReadState::failed);
+                ++frame.failed;
+                continue;
+            }
+
+            this->finish(pending, ReadState::done);
+            ++frame.completed;
+            frame.late += completed_at > pending.read.deadline;
+        }
+    }
+
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        std::vector<Pending>& queue = this->queues[priority];
+        size_t kept = 0;
+
+        for (Pending& pending : queue) {
+            ++frame.starved;
+            if (priority != static_cast<size_t>(ReadPriority::critical) && ++pending.deferrals > this->budget.max_deferrals) {
+                this->finish(pending, ReadState::dropped);
+                ++frame.dropped;
+                continue;
+            }
+            queue[kept++] = pending;
+        }
+        queue.resize(kept);
+    }
+
+    this->stats.completed += frame.completed;
+    this->stats.failed += frame.failed;
+    this->stats.starved += frame.starved;
+    this->stats.dropped += frame.dropped;
+    this->stats.expired += frame.expired;
+    this->stats.late += frame.late;
+    this->stats.round_trips += frame.round_trips;
+    this->stats.bytes += frame.bytes;
+
+    return frame;
+}
+
+void ReadScheduler::clear() {
+    for (std::vector<Pending>& queue : this->queues) {
+        for (const Pending& pending : queue) {
+            this->finish(pending, ReadState::dropped);
+        }
+        queue.clear();
+    }
+}
+
+size_t ReadScheduler::size() const {
+    size_t count = 0;
+    for (const std::vector<Pending>& queue : this->queues) {
+        count += queue.size();
+    }
+    return count;
+}
+
+void ReadScheduler::finish(const Pending& pending, ReadState state) const {
+    if (pending.read.state) {
+        *pending.read.state = state;
+    }
+}
@@ -0,0 +1,289 @@
+#include "include/VolkDMA/sharedframe.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+
+#include <windows.h>
+
+#include "include/VolkDMA/log.hh"
+
+static constexpr uint32_t shared_frame_magic = 0x564B4652; // "VKFR"
+static constexpr uint32_t shared_frame_version = 1;
+
+struct alignas(64) SharedFrameHeader {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t frame_size;
+    std::atomic<uint64_t> published;
+};
+
+struct alignas(64) SharedFrameSlot {
+    std::atomic<uint64_t> sequence;
+    uint64_t frame;
+    uint64_t size;
+};
+
+static size_t slot_stride(size_t frame_size) {
+    return (sizeof(SharedFrameSlot) + frame_size + 63) & ~size_t{ 63 };
+}
+
+static SharedFrameSlot* slot_at(const SharedFrameHeader* header, size_t frame_size, size_t index) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(const_cast<SharedFrameHeader*>(header)) + sizeof(SharedFrameHeader);
+    return reinterpret_cast<SharedFrameSlot*>(base + index * slot_stride(frame_size));
+}
+
+static uint8_t* slot_data(const SharedFrameSlot* slot) {
+    return reinterpret_cast<uint8_t*>(const_cast<SharedFrameSlot*>(slot)) + sizeof(SharedFrameSlot);
+}
+
+static std::wstring mapping_name(std::string_view name) {
+    std::wstring result = L"Local\\VolkDMA.";
+    result.append(name.begin(), name.end());
+    return result;
+}
+
+static void release_owner(HANDLE owner) {
+    ReleaseMutex(owner);
+    CloseHandle(owner);
+}
+
+FramePublisher::FramePublisher(std::string_view name, size_t frame_size, size_t slot_count) : frame_size(frame_size), slot_count(slot_count) {
+    if (name.empty() || frame_size == 0 || frame_size > 0xFFFFFFFF || slot_count < 2 || slot_count > 0xFFFFFFFF) {
+        Log::error("[SHARED] Invalid frame ring parameters.");
+        return;
+    }
+
+    // The owner mutex makes publishing exclusive. It is only abandoned when the previous
+    // publisher's thread died holding it, which is the one case where taking the ring over
+    // is safe; a publisher that is still running keeps it and the second one fails.
+    HANDLE owner = CreateMutexW(NULL, FALSE, (mapping_name(name) + L".owner").c_str());
+    if (!owner) {
+        Log::error("[SHARED] Failed to create frame ring owner mutex, error {}.", GetLastError());
+        return;
+    }
+
+    const DWORD wait = WaitForSingleObject(owner, 0);
+    if (wait != WAIT_OBJECT_0 && wait != WAIT_ABANDONED) {
+        Log::error("[SHARED] Frame ring is already owned by another publisher.");
+        CloseHandle(owner);
+        return;
+    }
+
+    const uint64_t total = sizeof(SharedFrameHeader) + static_cast<uint64_t>(slot_stride(frame_size)) * slot_count;
+    HANDLE handle = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, static_cast<DWORD>(total >> 32), static_cast<DWORD>(total), mapping_name(name).c_str());
+    if (!handle) {
+        Log::error("[SHARED] Failed to create frame ring mapping, error {}.", GetLastError());
+        release_owner(owner);
+        return;
+    }
+    const bool existed = GetLastError() == ERROR_ALREADY_EXISTS;
+
+    void* view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!view) {
+        Log::error("[SHARED] Failed to map frame ring, error {}.", GetLastError());
+        CloseHandle(handle);
+        release_owner(owner);
+        return;
+    }
+
+    SharedFrameHeader* ring = static_cast<SharedFrameHeader*>(view);
+    if (existed) {
+        // Holding the owner mutex, a restarted publisher may take over a ring that subscribers
+        // still hold open, as long as the geometry matches; frame numbering continues where
+        // it stopped.
+        if (ring->magic.load(std::memory_order_acquire) != shared_frame_magic || ring->version != shared_frame_version || ring->frame_size != frame_size || ring->slot_count != slot_count) {
+            Log::error("[SHARED] Frame ring already exists with a different layout.");
+            UnmapViewOfFile(view);
+            CloseHandle(handle);
+            release_owner(owner);
+            return;
+        }
+        this->frame_count = ring->published.load(std::memory_order_acquire);
+
+        // A publisher that died inside begin_frame/commit_frame leaves its slot at an odd
+        // sequence, which readers treat as a write in progress forever. Round every slot
+        // up to the next even value so the ring is consistent again.
+        for (size_t i = 0; i < slot_count; ++i) {
+            SharedFrameSlot* slot = slot_at(ring, frame_size, i);
+            const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+            if (sequence & 1) {
+                slot->sequence.store(sequence + 1, std::memory_order_release);
+            }
+        }
+    }
+    else {
+        ring->version = shared_frame_version;
+        ring->slot_count = static_cast<uint32_t>(slot_count);
+        ring->frame_size = static_cast<uint32_t>(frame_size);
+        ring->published.store(0, std::memory_order_relaxed);
+        ring->magic.store(shared_frame_magic, std::memory_order_release);
+    }
+
+    this->owner = owner;
+    this->mapping = handle;
+    this->header = ring;
+}
+
+FramePublisher::~FramePublisher() {
+    if (this->writing) {
+        this->commit_frame(0);
+    }
+    if (this->header) {
+        UnmapViewOfFile(this->header);
+    }
+    if (this->mapping) {
+        CloseHandle(this->mapping);
+    }
+    if (this->owner) {
+        release_owner(this->owner);
+    }
+}
+
+std::span<uint8_t> FramePublisher::begin_frame() {
+    if (!this->header) {
+        return {};
+    }
+
+    if (!this->writing) {
+        SharedFrameSlot* slot = slot_at(this->header, this->frame_size, this->frame_count % this->slot_count);
+        slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        this->writing = slot;
+    }
+
+    return { slot_data(this->writing), this->frame_size };
+}
+
+bool FramePublisher::commit_frame(size_t size) {
+    if (!this->writing || size > this->frame_size) {
+        return false;
+    }
+
+    this->writing->frame = this->frame_count;
+    this->writing->size = size;
+    this->writing->sequence.store(this->writing->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    this->writing = nullptr;
+
+    this->header->published.store(++this->frame_count, std::memory_order_release);
+    return true;
+}
+
+bool FramePublisher::publish(std::span<const uint8_t> data) {
+    if (data.size() > this->frame_size) {
+        return false;
+    }
+
+    std::span<uint8_t> frame = this->begin_frame();
+    if (frame.empty()) {
+        return false;
+    }
+
+    std::memcpy(frame.data(), data.data(), data.size());
+    return this->commit_frame(data.size());
+}
+
+FrameSubscriber::FrameSubscriber(std::string_view name) {
+    HANDLE handle = OpenFileMappingW(FILE_MAP_READ, FALSE, mapping_name(name).c_str());
+    if (!handle) {
+        Log::warning("[SHARED] Frame ring is not published yet.");
+        return;
+    }
+
+    void* view = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        Log::error("[SHARED] Failed to map frame ring, error {}.", GetLastError());
+        CloseHandle(handle);
+        return;
+    }
+
+    const SharedFrameHeader* ring = static_cast<const SharedFrameHeader*>(view);
+    if (ring->magic.load(std::memory_order_acquire) != shared_frame_magic || ring->version != shared_frame_version || ring->slot_count < 2) {
+        Log::error("[SHARED] Frame ring has an unknown layout.");
+        UnmapViewOfFile(view);
+        CloseHandle(handle);
+        return;
+    }
+
+    this->mapping = handle;
+    this->header = ring;
+    this->frame_size = ring->frame_size;
+    this->slot_count = ring->slot_count;
+}
+
+FrameSubscriber::~FrameSubscriber() {
+    if (this->header) {
+        UnmapViewOfFile(this->header);
+    }
+    if (this->mapping) {
+        CloseHandle(this->mapping);
+    }
+}
+
+bool FrameSubscriber::view_latest(FrameView& view) const {
+    if (!this->header) {
+        return false;
+    }
+
+    // The latest slot is only rewritten once the publisher laps the ring, so an odd
+    // sequence here is rare; re-reading the published counter moves on to the newer frame.
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const uint64_t published = this->header->published.load(std::memory_order_acquire);
+        if (published == 0) {
+            return false;
+        }
+
+        const size_t index = (published - 1) % this->slot_count;
+        const SharedFrameSlot* slot = this->get_slot(index);
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+
+        view.frame = slot->frame;
+        view.sequence = sequence;
+        view.slot = index;
+        view.data = { slot_data(slot), std::min<size_t>(slot->size, this->frame_size) };
+        return true;
+    }
+
+    return false;
+}
+
+bool FrameSubscriber::is_current(const FrameView& view) const {
+    if (!this->header || view.slot >= this->slot_count) {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return this->get_slot(view.slot)->sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+bool FrameSubscriber::read_latest(std::vector<uint8_t>& out, uint64_t* frame) const {
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        FrameView view;
+        if (!this->view_latest(view)) {
+            return false;
+        }
+
+        out.assign(view.data.begin(), view.data.end());
+        if (this->is_current(view)) {
+            if (frame) {
+                *frame = view.frame;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t FrameSubscriber::get_frame_count() const {
+    return this->header ? this->header->published.load(std::memory_order_acquire) : 0;
+}
+
+const SharedFrameSlot* FrameSubscriber::get_slot(size_t index) const {
+    return slot_at(this->header, this->frame_size, index);
+}
@@ -0,0 +1,244 @@
+#include "include/VolkDMA/symbols.hh"
+
+#include <cstdlib>
+#include <fstream>
+
+#include "external/vmm/vmmdll.h"
+
+#include "include/VolkDMA/dma.hh"
+#include "include/VolkDMA/internal/volkresource.hh"
+#include "include/VolkDMA/log.hh"
+
+SymbolResolver::SymbolResolver(const DMA& dma, std::filesystem::path cache_path) : dma(dma), cache_path(std::move(cache_path)) {
+    this->load();
+}
+
+SymbolResolver::~SymbolResolver() {
+    this->save();
+}
+
+uint64_t SymbolResolver::get_symbol_address(DWORD process_id, const std::string& module_name, const std::string& symbol_name) {
+    ModuleIdentity* identity = this->identify(process_id, module_name);
+    if (!identity) {
+        return 0;
+    }
+
+    auto& entries = this->cache[identity->key];
+    const std::string key = "sym:" + symbol_name;
+
+    if (auto it = entries.find(key); it != entries.end()) {
+        return identity->base + it->second;
+    }
+
+    if (!this->load_pdb(process_id, *identity)) {
+        return 0;
+    }
+
+    ULONG64 address = 0;
+    if (!VMMDLL_PdbSymbolAddress(this->dma.handle.get(), identity->pdb_module.c_str(), symbol_name.c_str(), &address) || address < identity->base) {
+        Log::error("[SYMBOLS] Failed to resolve symbol {} in {}.", symbol_name, module_name);
+        return 0;
+    }
+
+    entries[key] = address - identity->base;
+    this->dirty = true;
+
+    return address;
+}
+
+bool SymbolResolver::get_type_offset(DWORD process_id, const std::string& module_name, const std::string& type_name, const std::string& field_name, uint32_t& offset) {
+    ModuleIdentity* identity = this->identify(process_id, module_name);
+    if (!identity) {
+        return false;
+    }
+
+    auto& entries = this->cache[identity->key];
+    const std::string key = "type:" + type_name + "." + field_name;
+
+    if (auto it = entries.find(key); it != entries.end()) {
+        offset = static_cast<uint32_t>(it->second);
+        return true;
+    }
+
+    if (!this->load_pdb(process_id, *identity)) {
+        return false;
+    }
+
+    DWORD child_offset = 0;
+    if (!VMMDLL_PdbTypeChildOffset(this->dma.handle.get(), identity->pdb_module.c_str(), type_name.c_str(), field_name.c_str(), &child_offset)) {
+        Log::error("[SYMBOLS] Failed to resolve offset of {}.{} in {}.", type_name, field_name, module_name);
+        return false;
+    }
+
+    offset = child_offset;
+    entries[key] = child_offset;
+    this->dirty = true;
+
+    return true;
+}
+
+bool SymbolResolver::get_cached_value(DWORD process_id, const std::string& module_name, const std::string& key, uint64_t& value) {
+    ModuleIdentity* identity = this->identify(process_id, module_name);
+    if (!identity) {
+        return false;
+    }
+
+    const auto& entries = this->cache[identity->key];
+    auto it = entries.find("val:" + key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    value = it->second;
+    return true;
+}
+
+void SymbolResolver::store_cached_value(DWORD process_id, const std::string& module_name, const std::string& key, uint64_t value) {
+    ModuleIdentity* identity = this->identify(process_id, module_name);
+    if (!identity) {
+        return;
+    }
+
+    this->cache[identity->key]["val:" + key] = value;
+    this->dirty = true;
+}
+
+void SymbolResolver::store_symbol_address(DWORD process_id, const std::string& module_name, const std::string& symbol_name, uint64_t address) {
+    ModuleIdentity* identity = this->identify(process_id, module_name);
+    if (!identity || address < identity->base) {
+        return;
+    }
+
+    this->cache[identity->key]["sym:" + symbol_name] = address - identity->base;
+    this->dirty = true;
+}
+
+bool SymbolResolver::save() {
+    if (!this->dirty) {
+        return true;
+    }
+
+    std::error_code error;
+    if (this->cache_path.has_parent_path()) {
+        std::filesystem::create_directories(this->cache_path.parent_path(), error);
+    }
+
+    std::ofstream file(this->cache_path, std::ios::trunc);
+    if (!file.is_open()) {
+        Log::error("[SYMBOLS] Failed to write symbol cache.");
+        return false;
+    }
+
+    for (const auto& [identity, entries] : this->cache) {
+        for (const auto& [key, value] : entries) {
+            file << identity << '\t' << key << '\t' << std::hex << value << std::dec << '\n';
+        }
+    }
+
+    this->dirty = false;
+    return true;
+}
+
+std::filesystem::path SymbolResolver::get_default_cache_path() {
+    std::filesystem::path directory;
+
+    wchar_t* local_app_data = nullptr;
+    size_t length = 0;
+    if (_wdupenv_s(&local_app_data, &length, L"LOCALAPPDATA") == 0 && local_app_data) {
+        directory = local_app_data;
+    }
+    std::free(local_app_data);
+
+    if (directory.empty()) {
+        std::error_code error;
+        directory = std::filesystem::temp_directory_path(error);
+    }
+
+    return directory / "VolkDMA" / "symbol_cache.txt";
+}
+
+SymbolResolver::ModuleIdentity* SymbolResolver::identify(DWORD process_id, const std::string& module_name) {
+    const std::string lookup = std::to_string(process_id) + ":" + module_name;
+
+    // The module is looked up on every call so that an identity cached for a module that
+    // has since been unloaded and reloaded elsewhere, or for a reused process ID, is never
+    // used to rebase an offset. Debug information is only read when the identity changes.
+    VolkResource<VMMDLL_MAP_MODULEENTRY> module_entry{};
+    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), process_id, module_name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_NORMAL)) {
+        this->identities.erase(lookup);
+        Log::error("[SYMBOLS] Failed to find module: {}.", module_name);
+        return nullptr;
+    }
+
+    if (auto it = this->identities.find(lookup); it != this->identities.end()) {
+        if (it->second.base == module_entry->vaBase && it->second.image_size == module_entry->cbImageSize) {
+            return &it->second;
+        }
+        this->identities.erase(it);
+    }
+
+    if (!VMMDLL_Map_GetModuleFromNameU(this->dma.handle.get(), process_id, module_name.c_str(), module_entry.out(), VMMDLL_MODULE_FLAG_DEBUGINFO)) {
+        Log::error("[SYMBOLS] Failed to find module: {}.", module_name);
+        return nullptr;
+    }
+
+    const auto* debug_info = module_entry->pExDebugInfo;
+    if (!debug_info || !debug_info->uszGuid || !debug_info->uszPdbFilename || !*debug_info->uszGuid) {
+        Log::warning("[SYMBOLS] No debug information for module: {}.", module_name);
+        return nullptr;
+    }
+
+    ModuleIdentity identity{};
+    identity.key = std::string(debug_info->uszPdbFilename) + ":" + debug_info->uszGuid + ":" + std::to_string(debug_info->dwAge);
+    identity.base = module_entry->vaBase;
+    identity.image_size = module_entry->cbImageSize;
+
+    return &this->identities.emplace(lookup, std::move(identity)).first->second;
+}
+
+bool SymbolResolver::load_pdb(DWORD process_id, ModuleIdentity& identity) {
+    if (!identity.pdb_module.empty()) {
+        return true;
+    }
+
+    if (identity.pdb_attempted) {
+        return false;
+    }
+    identity.pdb_attempted = true;
+
+    char pdb_module[MAX_PATH] = {};
+    if (!VMMDLL_PdbLoad(this->dma.handle.get(), process_id, identity.base, pdb_module) || !*pdb_module) {
+        Log::error("[SYMBOLS] Failed to load PDB for {}.", identity.key);
+        return false;
+    }
+
+    identity.pdb_module = pdb_module;
+    return true;
+}
+
+void SymbolResolver::load() {
+    std::ifstream file(this->cache_path);
+    if (!file.is_open()) {
+        return;
+    }
+
+    // Identities and keys may contain spaces, so fields are split on tabs only. Lines that
+    // do not have exactly three fields are skipped and resolved again.
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t first = line.find('\t');
+        const size_t second = first == std::string::npos ? std::string::npos : line.find('\t', first + 1);
+        if (second == std::string::npos || line.find('\t', second + 1) != std::string::npos) {
+            continue;
+        }
+
+        const std::string value_text = line.substr(second + 1);
+        char* end = nullptr;
+        const uint64_t value = std::strtoull(value_text.c_str(), &end, 16);
+        if (value_text.empty() || *end != '\0') {
+            continue;
+        }
+
+        this->cache[line.substr(0, first)][line.substr(first + 1, second - first - 1)] = value;
+    }
+}
@@ -0,0 +1,310 @@
+#include "include/VolkDMA/traversal.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "include/VolkDMA/log.hh"
+
+Traversal::Traversal(const Process& process, TraversalLimits limits) : process(process), limits(limits) {}
+
+bool Traversal::read_pointer_array(uint64_t address, size_t count, std::vector<uint64_t>& pointers) const {
+    pointers.assign(count, 0);
+    if (count == 0) {
+        return true;
+    }
+
+    if (!this->process.is_valid_address(address)) {
+        return false;
+    }
+
+    ScatterContext scatter = this->process.acquire_scatter();
+    if (!scatter) {
+        return false;
+    }
+
+    const size_t pointers_per_chunk = std::max<size_t>(this->limits.chunk_size / sizeof(uint64_t), 1);
+    bool success = true;
+
+    for (size_t i = 0; i < count; i += pointers_per_chunk) {
+        const size_t chunk_count = std::min(pointers_per_chunk, count - i);
+        success &= scatter.add_read(address + i * sizeof(uint64_t), &pointers[i], chunk_count * sizeof(uint64_t));
+    }
+
+    success &= scatter.execute();
+    return success;
+}
+
+bool Traversal::walk_list(uint64_t list_head, std::vector<uint64_t>& entries, uint64_t entry_offset) const {
+    entries.clear();
+    if (!this->process.is_valid_address(list_head)) {
+        return false;
+    }
+
+    struct ListEntry {
+        uint64_t flink;
+        uint64_t blink;
+    };
+
+    // Both ends of the list are walked at once. When consecutive nodes sit at a constant
+    // stride, the nodes that would follow are read speculatively in the same round trip.
+    struct Direction {
+        bool forward;
+        uint64_t current;
+        int64_t stride = 0;
+        size_t depth = 1;
+        bool done = false;
+        std::vector<uint64_t> nodes;
+    };
+
+    Direction directions[2] = { { true, list_head, 0, 1, false, {} }, { false, list_head, 0, 1, false, {} } };
+    std::unordered_map<uint64_t, bool> owners{ { list_head, true } };
+    std::vector<uint64_t> planned;
+    std::vector<ListEntry> links;
+    size_t planned_count[2] = {};
+    bool intact = true;
+
+    ScatterContext scatter = this->process.acquire_scatter();
+    if (!scatter) {
+        return false;
+    }
+
+    while (!directions[0].done || !directions[1].done) {
+        planned.clear();
+        for (size_t d = 0; d < 2; ++d) {
+            Direction& direction = directions[d];
+            planned_count[d] = 0;
+            if (direction.done) {
+                continue;
+            }
+
+            planned.push_back(direction.current);
+            const size_t speculative = direction.stride != 0 ? direction.depth - 1 : 0;
+            for (size_t k = 1; k <= speculative; ++k) {
+                planned.push_back(direction.current + static_cast<uint64_t>(direction.stride * static_cast<int64_t>(k)));
+            }
+            planned_count[d] = speculative + 1;
+        }
+
+        links.assign(planned.size(), ListEntry{});
+
+        for (size_t i = 0; i < planned.size(); ++i) {
+            if (this->process.is_valid_address(planned[i])) {
+                scatter.add_read(planned[i], &links[i]);
+            }
+        }
+
+        if (!scatter.execute()) {
+            return false;
+        }
+
+        size_t first = 0;
+        for (size_t d = 0; d < 2; ++d) {
+            Direction& direction = directions[d];
+            if (direction.done) {
+                continue;
+            }
+
+            size_t hits = 0;
+            for (size_t k = 0; k < planned_count[d]; ++k) {
+                const ListEntry& link = links[first + k];
+                const uint64_t next = direction.forward ? link.flink : link.blink;
+
+                if (next == list_head) {
+                    direction.done = true;
+                    break;
+                }
+
+                if (!this->process.is_valid_address(next)) {
+                    intact = false;
+                    direction.done = true;
+                    break;
+                }
+
+                if (auto it = owners.find(next); it != owners.end()) {
+                    if (it->second == direction.forward) {
+                        intact = false;
+                    }
+                    directions[0].done = true;
+                    directions[1].done = true;
+                    break;
+                }
+
+                if (owners.size() - 1 >= this->limits.max_elements) {
+                    intact = false;
+                    directions[0].done = true;
+                    directions[1].done = true;
+                    break;
+                }
+
+                owners.emplace(next, direction.forward);
+                direction.nodes.push_back(next);
+                direction.stride = static_cast<int64_t>(next - direction.current);
+                direction.current = next;
+
+                if (k + 1 >= planned_count[d] || planned[first + k + 1] != next) {
+                    break;
+                }
+                ++hits;
+            }
+
+            if (planned_count[d] > 1) {
+                direction.depth = (hits + 1 == planned_count[d]) ? std::min(direction.depth * 2, this->limits.max_prefetch) : 1;
+            }
+            else {
+                direction.depth = std::min<size_t>(2, this->limits.max_prefetch);
+            }
+
+            first += planned_count[d];
+        }
+    }
+
+    entries.reserve(directions[0].nodes.size() + directions[1].nodes.size());
+    for (const uint64_t node : directions[0].nodes) {
+        entries.push_back(node - entry_offset);
+    }
+    for (auto it = directions[1].nodes.rbegin(); it != directions[1].nodes.rend(); ++it) {
+        entries.push_back(*it - entry_offset);
+    }
+
+    if (!intact) {
+        Log::error("[TRAVERSAL] List at 0x{:x} is broken, cyclic or exceeds {} entries.", list_head, this->limits.max_elements);
+    }
+
+    return intact;
+}
+
+bool Traversal::walk_tree(uint64_t root, std::span<const uint64_t> child_offsets, std::vector<uint64_t>& nodes, uint64_t sentinel) const {
+    nodes.clear();
+    if (root == sentinel) {
+        return true;
+    }
+
+    if (!this->process.is_valid_address(root)) {
+        return false;
+    }
+
+    if (child_offsets.empty()) {
+        nodes.push_back(root);
+        return true;
+    }
+
+    const auto [min_offset, max_offset] = std::minmax_element(child_offsets.begin(), child_offsets.end());
+    const uint64_t span_offset = *min_offset;
+    const size_t span_size = static_cast<size_t>(*max_offset - *min_offset) + sizeof(uint64_t);
+
+    // Nodes reachable from several parents are expanded once. Every edge is kept, so a
+    // cycle can be told apart from shared nodes once the whole graph is known.
+    std::unordered_map<uint64_t, size_t> indices{ { root, 0 } };
+    std::vector<std::pair<size_t, size_t>> edges;
+    std::vector<size_t> level{ 0 };
+    std::vector<size_t> next_level;
+    std::vector<uint8_t> staging;
+    std::vector<DWORD> bytes_read;
+    bool complete = true;
+
+    ScatterContext scatter = this->process.acquire_scatter();
+    if (!scatter) {
+        return false;
+    }
+
+    nodes.push_back(root);
+
+    while (!level.empty()) {
+        staging.assign(level.size() * span_size, 0);
+        bytes_read.assign(level.size(), 0);
+
+        for (size_t i = 0; i < level.size(); ++i) {
+            if (!scatter.add_read(nodes[level[i]] + span_offset, staging.data() + i * span_size, span_size, &bytes_read[i])) {
+                complete = false;
+            }
+        }
+
+        if (!scatter.execute()) {
+            return false;
+        }
+
+        next_level.clear();
+        for (size_t i = 0; i < level.size(); ++i) {
+            if (bytes_read[i] != span_size) {
+                complete = false;
+                continue;
+            }
+
+            for (const uint64_t offset : child_offsets) {
+                uint64_t child = 0;
+                std::memcpy(&child, staging.data() + i * span_size + (offset - span_offset), sizeof(child));
+
+                if (child == sentinel || !this->process.is_valid_address(child)) {
+                    continue;
+                }
+
+                if (auto it = indices.find(child); it != indices.end()) {
+                    edges.emplace_back(level[i], it->second);
+                    continue;
+                }
+
+                if (nodes.size() >= this->limits.max_elements) {
+                    Log::error("[TRAVERSAL] Tree at 0x{:x} exceeds {} nodes.", root, this->limits.max_elements);
+                    return false;
+                }
+
+                indices.emplace(child, nodes.size());
+                edges.emplace_back(level[i], nodes.size());
+                next_level.push_back(nodes.size());
+                nodes.push_back(child);
+            }
+        }
+
+        level.swap(next_level);
+    }
+
+    if (!complete) {
+        Log::error("[TRAVERSAL] Tree at 0x{:x} has nodes that could not be read.", root);
+    }
+
+    // Kahn's algorithm: nodes left with incoming edges after peeling lie on a cycle.
+    std::vector<size_t> incoming(nodes.size(), 0);
+    std::vector<size_t> first_edge(nodes.size() + 1, 0);
+    for (const auto& [parent, child] : edges) {
+        ++incoming[child];
+        ++first_edge[parent + 1];
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        first_edge[i + 1] += first_edge[i];
+    }
+
+    std::vector<size_t> children(edges.size());
+    std::vector<size_t> fill(first_edge.begin(), first_edge.end() - 1);
+    for (const auto& [parent, child] : edges) {
+        children[fill[parent]++] = child;
+    }
+
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (incoming[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    size_t peeled = 0;
+    while (!ready.empty()) {
+        const size_t node = ready.back();
+        ready.pop_back();
+        ++peeled;
+
+        for (size_t e = first_edge[node]; e < first_edge[node + 1]; ++e) {
+            if (--incoming[children[e]] == 0) {
+                ready.push_back(children[e]);
+            }
+        }
+    }
+
+    if (peeled != nodes.size()) {
+        Log::error("[TRAVERSAL] Tree at 0x{:x} contains a cycle.", root);
+        return false;
+    }
+
+    return complete;
+}
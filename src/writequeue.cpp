@@ -0,0 +1,118 @@
+#include "include/VolkDMA/writequeue.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "include/VolkDMA/log.hh"
+#include "include/VolkDMA/process.hh"
+
+WriteQueue::WriteQueue(const Process& process, WriteQueuePolicy policy) : process(process), policy(policy) {}
+
+WriteQueue::~WriteQueue() {
+    this->commit();
+}
+
+bool WriteQueue::push(uint64_t address, const void* buffer, size_t size) {
+    if (!this->process.is_valid_address(address) || !buffer || size == 0) {
+        return false;
+    }
+
+    if (this->ranges.empty()) {
+        this->oldest_write = std::chrono::steady_clock::now();
+    }
+
+    ++this->stats.writes_queued;
+    this->stats.bytes_queued += size;
+    this->pushed_bytes += size;
+
+    uint64_t begin = address;
+    uint64_t end = address + size;
+
+    auto first = this->ranges.upper_bound(begin);
+    if (first != this->ranges.begin()) {
+        auto previous = std::prev(first);
+        if (previous->first + previous->second.size() >= begin) {
+            first = previous;
+        }
+    }
+
+    auto last = first;
+    while (last != this->ranges.end() && last->first <= end) {
+        begin = std::min(begin, last->first);
+        end = std::max<uint64_t>(end, last->first + last->second.size());
+        ++last;
+    }
+
+    if (first == last) {
+        this->ranges.emplace_hint(last, address, std::vector<uint8_t>(static_cast<const uint8_t*>(buffer), static_cast<const uint8_t*>(buffer) + size));
+        this->queued_bytes += size;
+    }
+    else {
+        std::vector<uint8_t> merged(static_cast<size_t>(end - begin));
+        for (auto it = first; it != last; ++it) {
+            std::memcpy(merged.data() + (it->first - begin), it->second.data(), it->second.size());
+            this->queued_bytes -= it->second.size();
+        }
+        std::memcpy(merged.data() + (address - begin), buffer, size);
+
+        this->ranges.erase(first, last);
+        this->queued_bytes += merged.size();
+        this->ranges.emplace(begin, std::move(merged));
+    }
+
+    return this->should_flush() ? this->commit() : true;
+}
+
+bool WriteQueue::commit() {
+    if (this->ranges.empty()) {
+        return true;
+    }
+
+    ScatterContext scatter = this->process.acquire_scatter();
+    bool success = static_cast<bool>(scatter);
+
+    if (success) {
+        for (auto& [range_address, bytes] : this->ranges) {
+            success &= scatter.add_write(range_address, bytes.data(), bytes.size());
+        }
+        success &= scatter.execute();
+    }
+
+    if (success) {
+        this->stats.bytes_committed += this->pushed_bytes;
+        this->stats.bytes_written += this->queued_bytes;
+        this->stats.ranges_written += this->ranges.size();
+        ++this->stats.flushes;
+    }
+    else {
+        Log::error("[WRITEQUEUE] Failed to flush {} ranges ({} bytes).", this->ranges.size(), this->queued_bytes);
+        this->stats.bytes_failed += this->pushed_bytes;
+        ++this->stats.failed_flushes;
+    }
+
+    this->discard();
+    return success;
+}
+
+bool WriteQueue::poll() {
+    return this->should_flush() ? this->commit() : true;
+}
+
+void WriteQueue::discard() {
+    this->ranges.clear();
+    this->queued_bytes = 0;
+    this->pushed_bytes = 0;
+}
+
+bool WriteQueue::should_flush() const {
+    if (this->ranges.empty()) {
+        return false;
+    }
+
+    if (this->queued_bytes >= this->policy.max_bytes || this->ranges.size() >= this->policy.max_ranges) {
+        return true;
+    }
+
+    return this->policy.max_delay.count() > 0 && std::chrono::steady_clock::now() - this->oldest_write >= this->policy.max_delay;
+}